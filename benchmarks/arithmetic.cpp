@@ -0,0 +1,127 @@
+#include <ctpc/ctpc.hpp>
+#include "bench_utils.hpp"
+
+#include <cstdint>
+
+using namespace ctpc;
+
+// The recursive grammar from examples/arithmetic.cpp.
+namespace recursive {
+
+static constexpr auto ws = regex_match<"\\s*">;
+
+constexpr auto ignore_ws(auto&& parser) {
+    return delimited(ws, std::forward<decltype(parser)>(parser), ws);
+}
+
+static constexpr auto plus = ignore_ws(verbatim<"+">);
+static constexpr auto minus = ignore_ws(verbatim<"-">);
+static constexpr auto star = ignore_ws(verbatim<"*">);
+static constexpr auto slash = ignore_ws(verbatim<"/">);
+static constexpr auto lparen = ignore_ws(verbatim<"(">);
+static constexpr auto rparen = ignore_ws(verbatim<")">);
+
+static constexpr auto number = map(ignore_ws(regex_match<"\\d+">), [](Input auto&& input) {
+    int64_t value = 0;
+    for (auto c : input) {
+        value = (value * 10) + (static_cast<int64_t>(c) - '0');
+    }
+    return value;
+});
+
+template <Input I>
+constexpr ParseResultOf<int64_t, I> expr_(I input);
+static constexpr auto expr = CTPC_F(expr_);
+
+template <Input I>
+constexpr ParseResultOf<int64_t, I> term_(I input);
+static constexpr auto term = CTPC_F(term_);
+
+template <Input I>
+constexpr ParseResultOf<int64_t, I> primary_(I input);
+static constexpr auto primary = CTPC_F(primary_);
+
+template <Input I>
+constexpr ParseResultOf<int64_t, I> primary_(I input) {
+    return alt(
+        number,
+        delimited(lparen, expr, rparen)
+    )(input);
+}
+
+template <Input I>
+constexpr ParseResultOf<int64_t, I> term_(I input) {
+    return alt(
+        map(seq(primary, ignore(star), term), [](auto lhs, auto rhs) { return lhs * rhs; }),
+        map(seq(primary, ignore(slash), term), [](auto lhs, auto rhs) { return lhs / rhs; }),
+        primary
+    )(input);
+}
+
+template <Input I>
+constexpr ParseResultOf<int64_t, I> expr_(I input) {
+    return alt(
+        map(seq(term, ignore(plus), expr), [](auto lhs, auto rhs) { return lhs + rhs; }),
+        map(seq(term, ignore(minus), expr), [](auto lhs, auto rhs) { return lhs - rhs; }),
+        term
+    )(input);
+}
+
+}
+
+// The same language, with operator chains parsed by `binary_ops`.
+namespace precedence {
+
+using recursive::ignore_ws;
+using recursive::number;
+
+template <Input I>
+constexpr ParseResultOf<int64_t, I> expr_(I input);
+static constexpr auto expr = CTPC_F(expr_);
+
+static constexpr auto primary = alt(
+    number,
+    delimited(recursive::lparen, expr, recursive::rparen)
+);
+
+template <Input I>
+constexpr ParseResultOf<int64_t, I> expr_(I input) {
+    return binary_ops(
+        primary,
+        left_assoc(1, recursive::plus, [](int64_t lhs, int64_t rhs) { return lhs + rhs; }),
+        left_assoc(1, recursive::minus, [](int64_t lhs, int64_t rhs) { return lhs - rhs; }),
+        left_assoc(2, recursive::star, [](int64_t lhs, int64_t rhs) { return lhs * rhs; }),
+        left_assoc(2, recursive::slash, [](int64_t lhs, int64_t rhs) { return rhs == 0 ? lhs : lhs / rhs; })
+    )(input);
+}
+
+}
+
+// Generates a flat expression with some parenthesized groups. The
+// recursive grammar recurses once per operator, so inputs are kept small
+// enough for its stack depth.
+static std::string make_expression(size_t size) {
+    static constexpr std::string_view ops[] = {" + ", " - ", " * ", " / "};
+    std::string ret = "1";
+    for (size_t i = 0; ret.size() < size; ++i) {
+        ret += ops[i % 4];
+        if (i % 7 == 3) {
+            ret += "(12 + 34)";
+        } else {
+            ret += std::to_string(i % 97 + 1);
+        }
+    }
+    return ret;
+}
+
+template <typename P>
+static void arithmetic(benchmark::State& state, P parser) {
+    auto input = make_expression(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto res = parser(std::string_view{input});
+        benchmark::DoNotOptimize(res);
+    }
+    bench::set_bytes(state, input.size());
+}
+BENCHMARK_CAPTURE(arithmetic, recursive, recursive::expr)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK_CAPTURE(arithmetic, binary_ops, precedence::expr)->RangeMultiplier(4)->Range(64, 1 << 16);
@@ -0,0 +1,60 @@
+#ifndef CTPC_BENCH_UTILS_HPP
+#define CTPC_BENCH_UTILS_HPP
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std::string_view_literals;
+
+// Input sizes, in bytes, that each input size dependent benchmark is run with.
+#define CTPC_BENCH_SIZES RangeMultiplier(16)->Range(64, 1 << 20)
+
+namespace bench {
+
+// All inputs are generated from a fixed seed, so runs are comparable.
+inline std::mt19937_64& rng() {
+    static std::mt19937_64 gen{0x6374'7063};
+    return gen;
+}
+
+inline std::string random_text(size_t size, std::string_view alphabet) {
+    std::uniform_int_distribution<size_t> dist(0, alphabet.size() - 1);
+    std::string ret(size, '\0');
+    for (auto& c : ret) {
+        c = alphabet[dist(rng())];
+    }
+    return ret;
+}
+
+inline std::vector<uint8_t> random_bytes(size_t size) {
+    std::uniform_int_distribution<unsigned> dist(0, 255);
+    std::vector<uint8_t> ret(size);
+    for (auto& b : ret) {
+        b = static_cast<uint8_t>(dist(rng()));
+    }
+    return ret;
+}
+
+// Repeats `unit` until the result is at least `size` bytes long.
+inline std::string repeat(std::string_view unit, size_t size) {
+    std::string ret{};
+    ret.reserve(size + unit.size());
+    while (ret.size() < size) {
+        ret += unit;
+    }
+    return ret;
+}
+
+inline void set_bytes(benchmark::State& state, size_t bytes_per_iteration) {
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(bytes_per_iteration));
+}
+
+}
+
+#endif
@@ -0,0 +1,154 @@
+#include <ctpc/alt.hpp>
+#include <ctpc/arena.hpp>
+#include <ctpc/delimited.hpp>
+#include <ctpc/many0.hpp>
+#include <ctpc/map.hpp>
+#include <ctpc/preceded.hpp>
+#include <ctpc/separated_list.hpp>
+#include <ctpc/seq.hpp>
+#include <ctpc/regex_match.hpp>
+#include <ctpc/verbatim.hpp>
+#include "bench_utils.hpp"
+
+#include <array>
+
+using namespace ctpc;
+
+static constexpr auto keyword = alt(
+    verbatim<"alignas ">, verbatim<"alignof ">, verbatim<"auto ">,
+    verbatim<"bool ">, verbatim<"break ">, verbatim<"case ">,
+    verbatim<"catch ">, verbatim<"char ">, verbatim<"class ">,
+    verbatim<"const ">, verbatim<"constexpr ">, verbatim<"continue ">,
+    verbatim<"default ">, verbatim<"delete ">, verbatim<"do ">,
+    verbatim<"double ">, verbatim<"else ">, verbatim<"enum ">,
+    verbatim<"explicit ">, verbatim<"extern ">, verbatim<"false ">,
+    verbatim<"float ">, verbatim<"for ">, verbatim<"friend ">,
+    verbatim<"goto ">, verbatim<"if ">, verbatim<"inline ">,
+    verbatim<"int ">, verbatim<"long ">, verbatim<"mutable ">,
+    verbatim<"namespace ">, verbatim<"new ">, verbatim<"noexcept ">,
+    verbatim<"nullptr ">, verbatim<"operator ">, verbatim<"private ">,
+    verbatim<"protected ">, verbatim<"public ">, verbatim<"return ">,
+    verbatim<"short ">, verbatim<"signed ">, verbatim<"sizeof ">,
+    verbatim<"static ">, verbatim<"struct ">, verbatim<"switch ">,
+    verbatim<"template ">, verbatim<"this ">, verbatim<"throw ">,
+    verbatim<"true ">, verbatim<"try ">, verbatim<"typedef ">,
+    verbatim<"typename ">, verbatim<"union ">, verbatim<"unsigned ">,
+    verbatim<"using ">, verbatim<"virtual ">, verbatim<"void ">,
+    verbatim<"volatile ">, verbatim<"while ">
+);
+
+static constexpr std::array keywords{
+    "alignas "sv, "bool "sv, "constexpr "sv, "double "sv, "for "sv, "namespace "sv,
+    "private "sv, "static "sv, "template "sv, "unsigned "sv, "while "sv, "else "sv,
+};
+
+// An alternative of many literal branches, applied to a keyword stream.
+static void alt_many_branches(benchmark::State& state) {
+    std::string input{};
+    for (size_t i = 0; input.size() < static_cast<size_t>(state.range(0)); ++i) {
+        input += keywords[i % keywords.size()];
+    }
+    auto parser = many0(keyword, [](size_t count, auto) { return count + 1; }, size_t{0});
+    for (auto _ : state) {
+        auto res = parser(std::string_view{input});
+        benchmark::DoNotOptimize(res);
+    }
+    bench::set_bytes(state, input.size());
+}
+BENCHMARK(alt_many_branches)->CTPC_BENCH_SIZES;
+
+static constexpr auto word = regex_match<"[a-z]+ ">;
+
+// Collects every item into a `std::vector` with the default reduce.
+static void many0_default_reduce(benchmark::State& state) {
+    auto input = bench::repeat("lorem ipsum dolor sit amet "sv, static_cast<size_t>(state.range(0)));
+    auto parser = many0(word, utils::default_reduce, utils::default_reduce_init);
+    for (auto _ : state) {
+        auto res = parser(std::string_view{input});
+        benchmark::DoNotOptimize(res);
+    }
+    bench::set_bytes(state, input.size());
+}
+BENCHMARK(many0_default_reduce)->CTPC_BENCH_SIZES;
+
+// Reserves the result up front from a count of the item terminators.
+static void many0_sized_count_of(benchmark::State& state) {
+    auto input = bench::repeat("lorem ipsum dolor sit amet "sv, static_cast<size_t>(state.range(0)));
+    auto parser = many0_sized(word, utils::count_of(' '));
+    for (auto _ : state) {
+        auto res = parser(std::string_view{input});
+        benchmark::DoNotOptimize(res);
+    }
+    bench::set_bytes(state, input.size());
+}
+BENCHMARK(many0_sized_count_of)->CTPC_BENCH_SIZES;
+
+// Folds items into a scalar, to separate parsing from accumulation costs.
+static void many0_count(benchmark::State& state) {
+    auto input = bench::repeat("lorem ipsum dolor sit amet "sv, static_cast<size_t>(state.range(0)));
+    auto parser = many0(word, [](size_t count, auto) { return count + 1; }, size_t{0});
+    for (auto _ : state) {
+        auto res = parser(std::string_view{input});
+        benchmark::DoNotOptimize(res);
+    }
+    bench::set_bytes(state, input.size());
+}
+BENCHMARK(many0_count)->CTPC_BENCH_SIZES;
+
+static constexpr auto nested_input = "(lorem ipsum )(dolor )(sit amet consectetur )(adipiscing elit )"sv;
+
+// Builds a list of short lists, one allocation chain per inner list.
+template <typename R>
+static void nested_lists(benchmark::State& state, R reduce, bool use_arena) {
+    auto input = bench::repeat(nested_input, static_cast<size_t>(state.range(0)));
+    auto inner = many0(word, reduce, utils::default_reduce_init);
+    auto parser = many0(delimited(verbatim<"(">, inner, verbatim<")">), reduce, utils::default_reduce_init);
+    Arena arena{};
+    for (auto _ : state) {
+        if (use_arena) {
+            auto res = parse_with_arena(parser, std::string_view{input}, arena);
+            benchmark::DoNotOptimize(res);
+        } else {
+            auto res = parser(std::string_view{input});
+            benchmark::DoNotOptimize(res);
+        }
+        arena.release();
+    }
+    bench::set_bytes(state, input.size());
+}
+BENCHMARK_CAPTURE(nested_lists, default_reduce, utils::default_reduce, false)->CTPC_BENCH_SIZES;
+BENCHMARK_CAPTURE(nested_lists, arena_vector, arena_vector, true)->CTPC_BENCH_SIZES;
+
+static constexpr auto csv_field = regex_match<"[a-z]+">;
+
+// A comma separated list as `seq(item, many0(preceded(comma, item)))`,
+// splicing the first item into the list afterwards.
+static void comma_list_seq_many0(benchmark::State& state) {
+    auto input = bench::repeat("lorem,ipsum,dolor,sit,amet,"sv, static_cast<size_t>(state.range(0)));
+    input.pop_back();
+    static constexpr auto parser = map(
+        seq(csv_field, many0(preceded(verbatim<",">, csv_field), utils::default_reduce, utils::default_reduce_init)),
+        [](auto first, auto rest) {
+            rest.insert(rest.begin(), first);
+            return rest;
+        }
+    );
+    for (auto _ : state) {
+        auto res = parser(std::string_view{input});
+        benchmark::DoNotOptimize(res);
+    }
+    bench::set_bytes(state, input.size());
+}
+BENCHMARK(comma_list_seq_many0)->CTPC_BENCH_SIZES;
+
+static void comma_list_separated_list(benchmark::State& state) {
+    auto input = bench::repeat("lorem,ipsum,dolor,sit,amet,"sv, static_cast<size_t>(state.range(0)));
+    input.pop_back();
+    static constexpr auto parser = separated_list1(csv_field, verbatim<",">);
+    for (auto _ : state) {
+        auto res = parser(std::string_view{input});
+        benchmark::DoNotOptimize(res);
+    }
+    bench::set_bytes(state, input.size());
+}
+BENCHMARK(comma_list_separated_list)->CTPC_BENCH_SIZES;
@@ -0,0 +1,321 @@
+#include <ctpc/verbatim.hpp>
+#include <ctpc/regex_match.hpp>
+#include <ctpc/lexer.hpp>
+#include <ctpc/take.hpp>
+#include <ctpc/keyword.hpp>
+#include <ctpc/alt.hpp>
+#include <ctpc/map.hpp>
+#include <ctpc/integer.hpp>
+#include <ctpc/number.hpp>
+#include <ctpc/many0.hpp>
+#include <ctpc/seq.hpp>
+#include <ctpc/byte.hpp>
+#include "bench_utils.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <span>
+
+using namespace ctpc;
+
+static void verbatim_short(benchmark::State& state) {
+    auto input = bench::repeat("GET /index.html HTTP/1.1\r\n"sv, 64);
+    for (auto _ : state) {
+        std::string_view in{input};
+        benchmark::DoNotOptimize(in);
+        auto res = verbatim<"GET ">(in);
+        benchmark::DoNotOptimize(res);
+    }
+    bench::set_bytes(state, 4);
+}
+BENCHMARK(verbatim_short);
+
+static void verbatim_long(benchmark::State& state) {
+    auto input = bench::repeat("Content-Security-Policy-Report-Only: "sv, 64);
+    for (auto _ : state) {
+        std::string_view in{input};
+        benchmark::DoNotOptimize(in);
+        auto res = verbatim<"Content-Security-Policy-Report-Only: ">(in);
+        benchmark::DoNotOptimize(res);
+    }
+    bench::set_bytes(state, 37);
+}
+BENCHMARK(verbatim_long);
+
+// Matches a literal repeatedly until the end of the input.
+static void verbatim_repeated(benchmark::State& state) {
+    auto input = bench::repeat("key=value;"sv, static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::string_view in{input};
+        size_t count = 0;
+        while (auto res = verbatim<"key=value;">(in)) {
+            in = std::string_view(std::ranges::data(res.remaining()), std::ranges::size(res.remaining()));
+            ++count;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    bench::set_bytes(state, input.size());
+}
+BENCHMARK(verbatim_repeated)->CTPC_BENCH_SIZES;
+
+static void regex_match_identifier(benchmark::State& state) {
+    auto input = bench::random_text(static_cast<size_t>(state.range(0)), "abcdefghijklmnopqrstuvwxyz_0123456789");
+    input[0] = 'x';
+    for (auto _ : state) {
+        std::string_view in{input};
+        benchmark::DoNotOptimize(in);
+        auto res = regex_match<"[a-z_][a-z_0-9]*">(in);
+        benchmark::DoNotOptimize(res);
+    }
+    bench::set_bytes(state, input.size());
+}
+BENCHMARK(regex_match_identifier)->CTPC_BENCH_SIZES;
+
+// Splits text into lines, skipping each line terminator.
+template <typename P>
+static void lines(benchmark::State& state, P parser) {
+    auto input = bench::random_text(static_cast<size_t>(state.range(0)), "abcdefghijklmnopqrstuvwxyz ,.;:0123456789");
+    for (size_t i = 79; i < input.size(); i += 80) {
+        input[i] = '\n';
+    }
+    for (auto _ : state) {
+        std::string_view in{input};
+        size_t count = 0;
+        while (!in.empty()) {
+            auto res = parser(in);
+            count += std::ranges::size(*res);
+            auto rem = res.remaining();
+            in = std::string_view(std::ranges::data(rem), std::ranges::size(rem));
+            if (!in.empty()) {
+                in.remove_prefix(1);
+            }
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    bench::set_bytes(state, input.size());
+}
+BENCHMARK_CAPTURE(lines, take_till, take_till<'\n'>)->CTPC_BENCH_SIZES;
+BENCHMARK_CAPTURE(lines, regex_match, regex_match<"[^\n]*">)->CTPC_BENCH_SIZES;
+
+static constexpr auto source_line = "while (count <= 100) { total = total + count * 2.5; count = count + 1; }\n"sv;
+
+// Splits source text into tokens, skipping whitespace between them.
+template <typename P>
+static void tokenize(benchmark::State& state, P parser) {
+    auto input = bench::repeat(source_line, static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::string_view in{input};
+        size_t sum = 0;
+        while (true) {
+            in.remove_prefix(std::min(in.find_first_not_of(" \n"), in.size()));
+            auto res = parser(in);
+            if (!res) {
+                break;
+            }
+            sum += *res;
+            in = std::string_view(std::ranges::data(res.remaining()), std::ranges::size(res.remaining()));
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    bench::set_bytes(state, input.size());
+}
+
+static constexpr auto lexer_token = map(
+    lexer<"if|else|while", "[a-zA-Z_]\\w*", "\\d+(\\.\\d+)?", "[-+*/=<>]=?", "[(){};]">,
+    [](auto lexeme) { return lexeme.token; }
+);
+
+static constexpr auto alt_token = alt(
+    map(regex_match<"if|else|while">, [](auto) { return size_t{0}; }),
+    map(regex_match<"[a-zA-Z_]\\w*">, [](auto) { return size_t{1}; }),
+    map(regex_match<"\\d+(\\.\\d+)?">, [](auto) { return size_t{2}; }),
+    map(regex_match<"[-+*/=<>]=?">, [](auto) { return size_t{3}; }),
+    map(regex_match<"[(){};]">, [](auto) { return size_t{4}; })
+);
+
+BENCHMARK_CAPTURE(tokenize, lexer, lexer_token)->CTPC_BENCH_SIZES;
+BENCHMARK_CAPTURE(tokenize, alt_regex_match, alt_token)->CTPC_BENCH_SIZES;
+
+// Matches keywords from a table of 32, separated by spaces.
+template <typename P>
+static void keywords(benchmark::State& state, P parser) {
+    auto input = bench::repeat("SELECT DISTINCT AS FROM INNER JOIN ON WHERE AND GROUP BY HAVING ORDER BY LIMIT OFFSET UNION ALL "sv,
+                               static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::string_view in{input};
+        size_t count = 0;
+        while (auto res = parser(in)) {
+            auto rem = res.remaining();
+            in = std::string_view(std::ranges::data(rem), std::ranges::size(rem));
+            in.remove_prefix(std::min<size_t>(1, in.size()));
+            ++count;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    bench::set_bytes(state, input.size());
+}
+
+static constexpr auto keyword_trie = one_of_literals<"SELECT", "FROM", "WHERE", "INSERT", "INTO", "VALUES", "UPDATE", "SET", "DELETE", "CREATE", "TABLE", "DROP", "ALTER", "INDEX", "JOIN", "LEFT", "RIGHT", "INNER", "OUTER", "ON", "GROUP", "BY", "ORDER", "HAVING", "LIMIT", "OFFSET", "UNION", "ALL", "DISTINCT", "AS", "AND", "OR">;
+
+static constexpr auto keyword_alt = alt(
+    verbatim<"SELECT">,
+    verbatim<"FROM">,
+    verbatim<"WHERE">,
+    verbatim<"INSERT">,
+    verbatim<"INTO">,
+    verbatim<"VALUES">,
+    verbatim<"UPDATE">,
+    verbatim<"SET">,
+    verbatim<"DELETE">,
+    verbatim<"CREATE">,
+    verbatim<"TABLE">,
+    verbatim<"DROP">,
+    verbatim<"ALTER">,
+    verbatim<"INDEX">,
+    verbatim<"JOIN">,
+    verbatim<"LEFT">,
+    verbatim<"RIGHT">,
+    verbatim<"INNER">,
+    verbatim<"OUTER">,
+    verbatim<"ON">,
+    verbatim<"GROUP">,
+    verbatim<"BY">,
+    verbatim<"ORDER">,
+    verbatim<"HAVING">,
+    verbatim<"LIMIT">,
+    verbatim<"OFFSET">,
+    verbatim<"UNION">,
+    verbatim<"ALL">,
+    verbatim<"DISTINCT">,
+    verbatim<"AS">,
+    verbatim<"AND">,
+    verbatim<"OR">
+);
+
+BENCHMARK_CAPTURE(keywords, one_of_literals, keyword_trie)->CTPC_BENCH_SIZES;
+BENCHMARK_CAPTURE(keywords, alt_verbatim, keyword_alt)->CTPC_BENCH_SIZES;
+
+// Parses comma separated decimal numbers of varying length.
+template <typename P>
+static void decimals(benchmark::State& state, P parser) {
+    std::string input{};
+    std::uniform_int_distribution<unsigned> digits(1, 19);
+    while (input.size() < static_cast<size_t>(state.range(0))) {
+        input += bench::random_text(digits(bench::rng()), "0123456789");
+        input += ',';
+    }
+    for (auto _ : state) {
+        std::string_view in{input};
+        uint64_t sum = 0;
+        while (auto res = parser(in)) {
+            sum += *res;
+            auto rem = res.remaining();
+            in = std::string_view(std::ranges::data(rem), std::ranges::size(rem));
+            in.remove_prefix(std::min<size_t>(1, in.size()));
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    bench::set_bytes(state, input.size());
+}
+
+static constexpr auto regex_decimal = map(regex_match<"\\d+">, [](auto digits) {
+    uint64_t value = 0;
+    for (auto c : digits) {
+        value = value * 10 + static_cast<uint64_t>(c - '0');
+    }
+    return value;
+});
+
+BENCHMARK_CAPTURE(decimals, dec_int, dec_int<uint64_t>)->CTPC_BENCH_SIZES;
+BENCHMARK_CAPTURE(decimals, regex_match_map, regex_decimal)->CTPC_BENCH_SIZES;
+
+template <typename P>
+static void floats(benchmark::State& state, P parser) {
+    std::string input{};
+    std::uniform_real_distribution<double> values(-1e6, 1e6);
+    char buf[32];
+    while (input.size() < static_cast<size_t>(state.range(0))) {
+        auto res = std::to_chars(buf, buf + sizeof(buf), values(bench::rng()));
+        input.append(buf, res.ptr);
+        input += ',';
+    }
+    for (auto _ : state) {
+        std::string_view in{input};
+        double sum = 0;
+        while (auto res = parser(in)) {
+            sum += *res;
+            auto rem = res.remaining();
+            in = std::string_view(std::ranges::data(rem), std::ranges::size(rem));
+            in.remove_prefix(std::min<size_t>(1, in.size()));
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    bench::set_bytes(state, input.size());
+}
+
+static constexpr auto regex_float = map(regex_match<"-?\\d+(\\.\\d*)?([eE][-+]?\\d+)?">, [](auto text) {
+    return std::strtod(std::string(std::ranges::begin(text), std::ranges::end(text)).c_str(), nullptr);
+});
+
+BENCHMARK_CAPTURE(floats, float_, float_<double>)->CTPC_BENCH_SIZES;
+BENCHMARK_CAPTURE(floats, regex_match_strtod, regex_float)->CTPC_BENCH_SIZES;
+
+template <typename P>
+static void integers(benchmark::State& state, P parser, size_t width) {
+    auto input = bench::random_bytes(static_cast<size_t>(state.range(0)) / width * width);
+    for (auto _ : state) {
+        std::span<const uint8_t> in{input};
+        uint64_t sum = 0;
+        while (auto res = parser(in)) {
+            sum += static_cast<uint64_t>(*res);
+            in = in.subspan(width);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    bench::set_bytes(state, input.size());
+}
+BENCHMARK_CAPTURE(integers, uint8, uint8, 1)->CTPC_BENCH_SIZES;
+BENCHMARK_CAPTURE(integers, uint16_be, uint16_be, 2)->CTPC_BENCH_SIZES;
+BENCHMARK_CAPTURE(integers, uint32_le, uint32_le, 4)->CTPC_BENCH_SIZES;
+BENCHMARK_CAPTURE(integers, uint64_be, uint64_be, 8)->CTPC_BENCH_SIZES;
+
+template <typename P>
+static void varints(benchmark::State& state, P parser) {
+    std::vector<uint8_t> input{};
+    std::uniform_int_distribution<unsigned> width(1, 63);
+    while (input.size() < static_cast<size_t>(state.range(0))) {
+        auto value = bench::rng()() >> (64 - width(bench::rng()));
+        for (; value >= 0x80; value >>= 7) {
+            input.push_back(static_cast<uint8_t>(value | 0x80));
+        }
+        input.push_back(static_cast<uint8_t>(value));
+    }
+    for (auto _ : state) {
+        std::span<const uint8_t> in{input};
+        uint64_t sum = 0;
+        while (auto res = parser(in)) {
+            sum += *res;
+            in = in.last(std::ranges::size(res.remaining()));
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    bench::set_bytes(state, input.size());
+}
+
+// Decodes one byte at a time with combinators
+static constexpr auto byte_varint = map(
+    seq(take_while<[](uint8_t b) { return (b & 0x80) != 0; }>, byte),
+    [](auto more, std::byte last) {
+        uint64_t value = 0;
+        unsigned shift = 0;
+        for (auto b : more) {
+            value |= static_cast<uint64_t>(b & 0x7F) << shift;
+            shift += 7;
+        }
+        return value | (static_cast<uint64_t>(last) << shift);
+    }
+);
+
+BENCHMARK_CAPTURE(varints, uleb128, uleb128<uint64_t>)->CTPC_BENCH_SIZES;
+BENCHMARK_CAPTURE(varints, take_while_map, byte_varint)->CTPC_BENCH_SIZES;
@@ -0,0 +1,85 @@
+#include <ctpc/utf.hpp>
+#include "bench_utils.hpp"
+
+using namespace ctpc;
+
+// Mostly ASCII text with some multibyte sequences, like typical source
+// code or logs.
+static std::string mixed_utf8(size_t size) {
+    return bench::repeat("The quick brown fox jumps over the lazy dog. \xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80 "sv, size);
+}
+
+template <typename To>
+static void utf8_convert(benchmark::State& state) {
+    auto input = mixed_utf8(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        size_t count = 0;
+        for (auto c : utils::utf_convert<To>(std::string_view{input})) {
+            benchmark::DoNotOptimize(c);
+            ++count;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    bench::set_bytes(state, input.size());
+}
+BENCHMARK(utf8_convert<char32_t>)->CTPC_BENCH_SIZES;
+BENCHMARK(utf8_convert<char16_t>)->CTPC_BENCH_SIZES;
+
+static void utf16_to_utf8(benchmark::State& state) {
+    std::u16string input{};
+    for (auto c : utils::utf_convert<char16_t>(std::string_view{mixed_utf8(static_cast<size_t>(state.range(0)))})) {
+        input.push_back(c);
+    }
+    for (auto _ : state) {
+        size_t count = 0;
+        for (auto c : utils::utf_convert<char8_t>(std::u16string_view{input})) {
+            benchmark::DoNotOptimize(c);
+            ++count;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    bench::set_bytes(state, input.size() * sizeof(char16_t));
+}
+BENCHMARK(utf16_to_utf8)->CTPC_BENCH_SIZES;
+
+template <typename To>
+static void utf8_transcode(benchmark::State& state) {
+    auto input = mixed_utf8(static_cast<size_t>(state.range(0)));
+    std::basic_string<To> output(utils::utf_transcode_bound<To, char>(input.size()), To{});
+    for (auto _ : state) {
+        auto res = utils::utf_transcode(input, output);
+        benchmark::DoNotOptimize(res);
+        benchmark::DoNotOptimize(output.data());
+    }
+    bench::set_bytes(state, input.size());
+}
+BENCHMARK(utf8_transcode<char32_t>)->CTPC_BENCH_SIZES;
+BENCHMARK(utf8_transcode<char16_t>)->CTPC_BENCH_SIZES;
+
+static void ascii_transcode(benchmark::State& state) {
+    auto input = bench::random_text(static_cast<size_t>(state.range(0)), "abcdefghijklmnopqrstuvwxyz ,.\n");
+    std::u16string output(input.size(), u'\0');
+    for (auto _ : state) {
+        auto res = utils::utf_transcode(input, output);
+        benchmark::DoNotOptimize(res);
+        benchmark::DoNotOptimize(output.data());
+    }
+    bench::set_bytes(state, input.size());
+}
+BENCHMARK(ascii_transcode)->CTPC_BENCH_SIZES;
+
+template <typename To>
+static void ascii_convert(benchmark::State& state) {
+    auto input = bench::random_text(static_cast<size_t>(state.range(0)), "abcdefghijklmnopqrstuvwxyz ,.\n");
+    for (auto _ : state) {
+        size_t count = 0;
+        for (auto c : utils::utf_convert<To>(std::string_view{input})) {
+            benchmark::DoNotOptimize(c);
+            ++count;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    bench::set_bytes(state, input.size());
+}
+BENCHMARK(ascii_convert<char32_t>)->CTPC_BENCH_SIZES;
+BENCHMARK(ascii_convert<char16_t>)->CTPC_BENCH_SIZES;
@@ -20,13 +20,7 @@ static constexpr auto slash = ignore_ws(verbatim<"/">);
 static constexpr auto lparen = ignore_ws(verbatim<"(">);
 static constexpr auto rparen = ignore_ws(verbatim<")">);
 
-static constexpr auto number = map(ignore_ws(regex_match<"\\d+">), [](Input auto&& input) {
-    int64_t value = 0;
-    for (auto c : input) {
-        value = (value * 10) + (static_cast<int64_t>(c) - '0');
-    }
-    return value;
-});
+static constexpr auto number = ignore_ws(dec_int<int64_t>);
 
 static constexpr auto num_expr = alt(
     map(preceded(minus, number), [](auto value) { return -value; }),
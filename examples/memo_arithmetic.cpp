@@ -0,0 +1,156 @@
+#include <ctpc/ctpc.hpp>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+using namespace ctpc;
+
+using namespace std::string_view_literals;
+
+// The same grammar as arithmetic.cpp, with each recursive rule wrapped in
+// `memo`. Without memoization, every level of nesting re-parses the
+// enclosed expression several times over, so parse time grows
+// exponentially with nesting depth.
+
+static constexpr auto ws = regex_match<"\\s*">;
+
+constexpr auto ignore_ws(auto&& parser) {
+    return delimited(ws, std::forward<decltype(parser)>(parser), ws);
+}
+
+static constexpr auto plus = ignore_ws(verbatim<"+">);
+static constexpr auto minus = ignore_ws(verbatim<"-">);
+static constexpr auto star = ignore_ws(verbatim<"*">);
+static constexpr auto slash = ignore_ws(verbatim<"/">);
+static constexpr auto lparen = ignore_ws(verbatim<"(">);
+static constexpr auto rparen = ignore_ws(verbatim<")">);
+
+static constexpr auto number = ignore_ws(dec_int<int64_t>);
+
+template <Input I>
+constexpr ParseResultOf<int64_t, I> expr_(I input);
+static constexpr auto expr = memo(CTPC_F(expr_));
+
+template <Input I>
+constexpr ParseResultOf<int64_t, I> term_(I input);
+static constexpr auto term = memo(CTPC_F(term_));
+
+template <Input I>
+constexpr ParseResultOf<int64_t, I> unary_(I input);
+static constexpr auto unary = memo(CTPC_F(unary_));
+
+template <Input I>
+constexpr ParseResultOf<int64_t, I> primary_(I input);
+static constexpr auto primary = CTPC_F(primary_);
+
+template <Input I>
+constexpr ParseResultOf<int64_t, I> primary_(I input) {
+    return alt(
+        number,
+        delimited(lparen, expr, rparen)
+    )(input);
+}
+
+template <Input I>
+constexpr ParseResultOf<int64_t, I> unary_(I input) {
+    return alt(
+        map(preceded(minus, unary), [](auto value) { return -value; }),
+        primary
+    )(input);
+}
+
+template <Input I>
+constexpr ParseResultOf<int64_t, I> term_(I input) {
+    return alt(
+        map(seq(unary, ignore(star), term), [](auto lhs, auto rhs) { return lhs * rhs; }),
+        map(seq(unary, ignore(slash), term), [](auto lhs, auto rhs) { return lhs / rhs; }),
+        unary
+    )(input);
+}
+
+template <Input I>
+constexpr ParseResultOf<int64_t, I> expr_(I input) {
+    return alt(
+        map(seq(term, ignore(plus), expr), [](auto lhs, auto rhs) { return lhs + rhs; }),
+        map(seq(term, ignore(minus), expr), [](auto lhs, auto rhs) { return lhs - rhs; }),
+        term
+    )(input);
+}
+
+constexpr int64_t evaluate(std::string_view input) {
+    MemoTable table;
+    return *expr(memo_input(input, table));
+}
+
+static std::string nested(size_t depth) {
+    std::string ret;
+    for (size_t i = 0; i < depth; ++i) {
+        ret += "(1 + ";
+    }
+    ret += "1";
+    ret.append(depth, ')');
+    return ret;
+}
+
+template <typename F>
+static double time_ms(F&& func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+static void benchmark() {
+    static constexpr size_t max_plain_depth = 6;
+    MemoTable table;
+
+    std::cout << "depth\tbytes\tplain (ms)\tmemo (ms)\n";
+    for (size_t depth = 1; depth <= 512; depth *= 2) {
+        auto input = nested(depth);
+        std::string_view in = input;
+
+        std::cout << depth << '\t' << input.size() << '\t';
+        if (depth <= max_plain_depth) {
+            std::cout << time_ms([&] {
+                if (!expr(in)) {
+                    std::cerr << "plain parse failed\n";
+                }
+            });
+        } else {
+            std::cout << '-';
+        }
+        std::cout << '\t' << time_ms([&] {
+            table.clear();
+            if (!expr(memo_input(in, table))) {
+                std::cerr << "memo parse failed\n";
+            }
+        }) << '\n';
+    }
+}
+
+int main(int argc, char** argv) {
+    static constexpr auto expression = "1 + (2 + 3) * -(1 + 1)"sv;
+    static_assert(evaluate(expression) == -9, "test failure!");
+
+    if (argc < 2) {
+        benchmark();
+        return 0;
+    }
+
+    int ret = 0;
+    MemoTable table;
+    for (size_t i = 1; i < static_cast<size_t>(argc); ++i) {
+        std::string_view input = argv[i];
+        table.clear();
+        auto res = expr(memo_input(input, table));
+        if (res) {
+            std::cout << input << " = " << *res << '\n';
+        } else {
+            std::cout << "failed to parse \"" << input << "\"\n";
+            ++ret;
+        }
+    }
+    return ret;
+}
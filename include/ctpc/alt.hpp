@@ -1,15 +1,35 @@
 #ifndef CTPC_ALT_HPP
 #define CTPC_ALT_HPP
 
+#include <array>
+#include <cstdint>
+#include <optional>
+
 #include "input.hpp"
 #include "parser.hpp"
 #include "parse_result.hpp"
 #include "utils.hpp"
+#include "first_set.hpp"
+#include "error.hpp"
 
 namespace ctpc {
 
 namespace detail {
 
+template <size_t N>
+using alt_mask_t = std::conditional_t<N <= 8, uint8_t,
+                   std::conditional_t<N <= 16, uint16_t,
+                   std::conditional_t<N <= 32, uint32_t, uint64_t>>>;
+
+// Maps the first element of the input to the set of alternatives that may
+// accept it. Bit `i` of a mask corresponds to the `i`th alternative.
+template <typename Mask>
+struct AltDispatchTable {
+    std::array<Mask, 256> narrow{};
+    Mask wide{};
+    Mask empty{};
+};
+
 template <typename... P>
 struct AltParser;
 
@@ -44,23 +64,138 @@ struct AltParser<P1, PN...> {
     template <typename Ret, ParseableBy<P1> I>
     constexpr auto call(I input) const -> ParseResultOf<Ret, I> {
         auto res = parser_(input);
-        if (res) {
+        if (res || res.incomplete()) {
+            // An incomplete alternative might still match once more
+            // input arrives, so later alternatives are not tried.
             return res;
         } else {
             return inner_.template call<Ret>(input);
         }
     }
 
+    // Same as `call`, but skips alternatives whose bit in `mask` is unset.
+    template <typename Ret, ParseableBy<P1> I, typename Mask>
+    constexpr auto call_masked(I input, Mask mask) const -> ParseResultOf<Ret, I> {
+        if ((mask & 1) != 0) {
+            auto res = parser_(input);
+            if (res || res.incomplete()) {
+                return res;
+            }
+        }
+        if constexpr (sizeof...(PN) == 0) {
+            return fail<Ret>(input);
+        } else {
+            mask = static_cast<Mask>(mask >> 1);
+            if (mask == 0) {
+                return fail<Ret>(input);
+            }
+            return inner_.template call_masked<Ret>(input, mask);
+        }
+    }
+
     template <typename I>
     using ret_t = typename std::remove_cvref_t<decltype(std::declval<P1&>()(std::declval<I>()))>::value_type;
 
+    template <typename Elem>
+    static constexpr std::array<std::optional<FirstSet>, sizeof...(PN) + 1> first_sets{
+        first_set_of<P1, Elem>(),
+        first_set_of<PN, Elem>()...
+    };
+
+    // Dispatching on the first element is only worthwhile if at least one
+    // alternative has a known first set.
+    template <typename Elem>
+    static constexpr bool dispatchable = [] {
+        if constexpr (KeyedElement<Elem> && sizeof...(PN) < 64) {
+            for (const auto& set : first_sets<Elem>) {
+                if (set.has_value()) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }();
+
+    template <typename Elem>
+    static constexpr auto make_dispatch_table() {
+        using mask_t = alt_mask_t<sizeof...(PN) + 1>;
+        AltDispatchTable<mask_t> table{};
+        for (size_t i = 0; i < first_sets<Elem>.size(); ++i) {
+            const auto& set = first_sets<Elem>[i];
+            auto bit = static_cast<mask_t>(mask_t{1} << i);
+            for (uint32_t unit = 0; unit < table.narrow.size(); ++unit) {
+                if (!set || set->contains(unit)) {
+                    table.narrow[unit] |= bit;
+                }
+            }
+            if (!set || set->contains_wide()) {
+                table.wide |= bit;
+            }
+            if (!set) {
+                table.empty |= bit;
+            }
+        }
+        return table;
+    }
+
+    template <typename Elem>
+    static constexpr auto dispatch_table = make_dispatch_table<Elem>();
+
+    // One bit for each alternative
+    static constexpr auto all_bits = [] {
+        using mask_t = alt_mask_t<sizeof...(PN) + 1>;
+        if constexpr (sizeof...(PN) + 1 == sizeof(mask_t) * 8) {
+            return static_cast<mask_t>(~mask_t{0});
+        } else {
+            return static_cast<mask_t>((mask_t{1} << (sizeof...(PN) + 1)) - 1);
+        }
+    }();
+
   public:
     explicit constexpr AltParser(P1&& parser, PN&&... inner)
         : parser_(std::forward<P1>(parser)),
           inner_(std::forward<PN>(inner)...) {}
 
+    template <typename Elem>
+    static constexpr std::optional<FirstSet> first_set() {
+        FirstSet ret{};
+        for (const auto& set : first_sets<Elem>) {
+            if (!set) {
+                return std::nullopt;
+            }
+            ret |= *set;
+        }
+        return ret;
+    }
+
     constexpr auto operator()(ParseableBy<P1> auto input) const {
-        return call<ret_t<decltype(input)>>(input);
+        using elem_t = std::remove_cvref_t<std::ranges::range_value_t<decltype(input)>>;
+        if constexpr (dispatchable<elem_t>) {
+            const auto& table = dispatch_table<elem_t>;
+            auto begin = std::ranges::begin(input);
+            auto mask = table.empty;
+            if (begin != std::ranges::end(input)) {
+                auto unit = element_key<elem_t>(*begin);
+                mask = unit < table.narrow.size() ? table.narrow[unit] : table.wide;
+            } else if constexpr (StreamingInput<decltype(input)>) {
+                // Every alternative may be waiting for its first element
+                return call<ret_t<decltype(input)>>(input);
+            }
+            if (mask != 0) {
+                auto res = call_masked<ret_t<decltype(input)>>(input, mask);
+                if (res || res.incomplete() || !reporting_errors()) [[likely]] {
+                    return res;
+                }
+            } else if (!reporting_errors()) [[likely]] {
+                return fail<ret_t<decltype(input)>>(input);
+            }
+            // Try only the skipped alternatives, so that they report what
+            // they expected to the error context without running the
+            // others twice
+            return call_masked<ret_t<decltype(input)>>(input, static_cast<decltype(mask)>(~mask & all_bits));
+        } else {
+            return call<ret_t<decltype(input)>>(input);
+        }
     }
 };
 
@@ -73,7 +208,33 @@ struct Alt {
     }
 };
 
+/// @brief Tries parsers in order until one succeeds
 /// @ingroup ctpc_combinators
+///
+/// Combinator signature:
+/// ```
+/// alt(Parser parser...) -> T
+/// ```
+///
+/// Each parser is attempted on the same input, in the order given, and the
+/// result of the first parser that succeeds is returned. All parsers must
+/// have the same result type.
+///
+/// When some of the parsers are known to require a particular first
+/// element, such as a `verbatim` literal or a `regex_match` pattern that
+/// starts with a single character or bracket expression (also when wrapped
+/// in `seq`, `map`, `ignore`, etc.), the first element of the input is
+/// looked up in a table computed at compile time, and parsers that cannot
+/// match it are skipped entirely. Other parsers are always attempted, so
+/// the result is the same as trying every parser in turn.
+///
+/// With a streaming input (see `StreamEnd`), an alternative that returns
+/// an incomplete result ends the search, and its result is returned, since
+/// it may still succeed once more input is available.
+///
+/// When every alternative fails within `parse_with_errors`, the skipped
+/// alternatives are also attempted, so that the error context lists
+/// everything that could have matched.
 static constexpr Alt alt{};
 
 }
@@ -0,0 +1,280 @@
+#ifndef CTPC_ARENA_HPP
+#define CTPC_ARENA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "parser.hpp"
+#include "input.hpp"
+#include "parse_result.hpp"
+#include "utils.hpp"
+
+namespace ctpc {
+
+/// @brief A monotonic memory arena
+///
+/// @details
+/// Memory is handed out from large blocks by bumping a pointer, and is
+/// only returned when the whole arena is released or destroyed, so
+/// building many small containers costs a few large allocations instead
+/// of one allocation per container. Objects placed in the arena are not
+/// destroyed by it. An arena must not be used from several threads at
+/// once.
+class Arena {
+  private:
+    struct Block {
+        Block* prev;
+        size_t size;
+    };
+
+    static constexpr size_t header_size = (sizeof(Block) + alignof(std::max_align_t) - 1) /
+                                          alignof(std::max_align_t) * alignof(std::max_align_t);
+
+    Block* head_{nullptr};
+    std::byte* ptr_{nullptr};
+    std::byte* end_{nullptr};
+    size_t block_size_;
+    size_t next_block_size_;
+    size_t used_{0};
+
+    void* allocate_slow(size_t size, size_t align) {
+        auto needed = size + align;
+        auto block_size = std::max(next_block_size_, needed);
+        auto block = static_cast<Block*>(::operator new(header_size + block_size));
+        block->prev = head_;
+        block->size = block_size;
+        head_ = block;
+        next_block_size_ = std::max(next_block_size_, std::min(block_size * 2, max_block_size));
+
+        auto base = reinterpret_cast<std::byte*>(block) + header_size;
+        auto addr = reinterpret_cast<uintptr_t>(base);
+        auto aligned = base + ((align - addr % align) % align);
+        ptr_ = aligned + size;
+        end_ = base + block_size;
+        used_ += size;
+        return aligned;
+    }
+
+  public:
+    /// @brief Blocks never grow beyond this size, except to fit a single
+    /// larger allocation.
+    static constexpr size_t max_block_size = size_t{16} << 20;
+
+    /// @brief Creates an arena whose first block holds `block_size` bytes
+    ///
+    /// @details
+    /// No memory is allocated until the arena is first used. Each
+    /// following block is twice as large as the previous one.
+    explicit Arena(size_t block_size = size_t{64} << 10)
+        : block_size_(std::max<size_t>(block_size, 64)),
+          next_block_size_(block_size_) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    Arena(Arena&& other) noexcept
+        : head_(std::exchange(other.head_, nullptr)),
+          ptr_(std::exchange(other.ptr_, nullptr)),
+          end_(std::exchange(other.end_, nullptr)),
+          block_size_(other.block_size_),
+          next_block_size_(std::exchange(other.next_block_size_, other.block_size_)),
+          used_(std::exchange(other.used_, 0)) {}
+
+    Arena& operator=(Arena&& other) noexcept {
+        if (this != &other) {
+            release();
+            head_ = std::exchange(other.head_, nullptr);
+            ptr_ = std::exchange(other.ptr_, nullptr);
+            end_ = std::exchange(other.end_, nullptr);
+            block_size_ = other.block_size_;
+            next_block_size_ = std::exchange(other.next_block_size_, other.block_size_);
+            used_ = std::exchange(other.used_, 0);
+        }
+        return *this;
+    }
+
+    ~Arena() {
+        release();
+    }
+
+    /// @brief Allocates `size` bytes aligned to `align`, which must be a
+    /// power of two
+    void* allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+        if (ptr_ != nullptr) {
+            auto addr = reinterpret_cast<uintptr_t>(ptr_);
+            auto aligned = ptr_ + ((align - addr % align) % align);
+            if (aligned <= end_ && size <= static_cast<size_t>(end_ - aligned)) {
+                ptr_ = aligned + size;
+                used_ += size;
+                return aligned;
+            }
+        }
+        return allocate_slow(size, align);
+    }
+
+    /// @brief Frees all memory allocated from the arena at once
+    void release() noexcept {
+        while (head_ != nullptr) {
+            auto prev = head_->prev;
+            ::operator delete(static_cast<void*>(head_));
+            head_ = prev;
+        }
+        ptr_ = nullptr;
+        end_ = nullptr;
+        next_block_size_ = block_size_;
+        used_ = 0;
+    }
+
+    /// @brief The number of bytes allocated from the arena so far
+    size_t used() const noexcept {
+        return used_;
+    }
+};
+
+namespace detail {
+
+// The arena installed on this thread by `parse_with_arena`, if any.
+inline thread_local Arena* current_arena = nullptr;
+
+}
+
+/// @brief Allocator drawing from the arena of the enclosing
+/// `parse_with_arena`
+///
+/// @details
+/// The arena is captured when the allocator is created. Outside of
+/// `parse_with_arena`, and during constant evaluation, memory comes from
+/// `std::allocator` instead, so containers using this allocator work
+/// anywhere.
+template <typename T>
+class ArenaAllocator {
+  private:
+    Arena* arena_{nullptr};
+
+    template <typename U>
+    friend class ArenaAllocator;
+
+  public:
+    using value_type = T;
+
+    constexpr ArenaAllocator() noexcept {
+        if (!std::is_constant_evaluated()) {
+            arena_ = detail::current_arena;
+        }
+    }
+
+    explicit constexpr ArenaAllocator(Arena* arena) noexcept
+        : arena_(arena) {}
+
+    template <typename U>
+    constexpr ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+        : arena_(other.arena_) {}
+
+    constexpr T* allocate(size_t n) {
+        if (std::is_constant_evaluated() || arena_ == nullptr) {
+            return std::allocator<T>{}.allocate(n);
+        }
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    constexpr void deallocate(T* ptr, size_t n) noexcept {
+        if (std::is_constant_evaluated() || arena_ == nullptr) {
+            std::allocator<T>{}.deallocate(ptr, n);
+        }
+    }
+
+    constexpr Arena* arena() const noexcept {
+        return arena_;
+    }
+
+    template <typename U>
+    constexpr bool operator==(const ArenaAllocator<U>& other) const noexcept {
+        return arena_ == other.arena_;
+    }
+};
+
+/// @brief A `std::vector` allocated from the current arena
+///
+/// @details
+/// See `ArenaAllocator`.
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+namespace utils {
+
+struct ArenaReduce {
+    template <typename Item>
+    constexpr ArenaVector<std::remove_cvref_t<Item>> operator()(ArenaVector<std::remove_cvref_t<Item>> accum, Item&& item) const {
+        default_reduce(reduce_in_place, accum, std::forward<Item>(item));
+        return accum;
+    }
+
+    template <typename Item>
+    constexpr void operator()(ReduceInPlace tag, ArenaVector<std::remove_cvref_t<Item>>& accum, Item&& item) const {
+        default_reduce(tag, accum, std::forward<Item>(item));
+    }
+};
+
+}
+
+/// @brief Reduce function collecting items into an `ArenaVector`
+///
+/// @details
+/// A drop-in replacement for `utils::default_reduce` in `many0`, `many1`,
+/// `count` and similar combinators. Used with `utils::default_reduce_init`,
+/// each list is allocated from the arena installed by `parse_with_arena`,
+/// or from the heap when there is none.
+///
+/// ```
+/// static constexpr auto args = many0(arg, arena_vector, utils::default_reduce_init);
+/// ```
+static constexpr utils::ArenaReduce arena_vector{};
+
+struct ParseWithArena {
+    template <typename P, Input I>
+        requires ParseableBy<I, P>
+    auto operator()(P&& parser, I input, Arena& arena) const {
+        struct Scope {
+            Arena* prev;
+
+            ~Scope() {
+                detail::current_arena = prev;
+            }
+        } scope{std::exchange(detail::current_arena, &arena)};
+        return parser(std::move(input));
+    }
+};
+
+/// @brief Runs a parser with an arena for its allocations
+///
+/// Signature:
+/// ```
+/// parse_with_arena(Parser parser, Input input, Arena& arena) -> ParseResult
+/// ```
+///
+/// Installs `arena` as the current arena of the calling thread while
+/// `parser` runs, so that every `ArenaVector` and `ArenaAllocator` created
+/// during the parse, such as the lists built by `arena_vector`, draws its
+/// memory from `arena`. The result may refer to memory in `arena`, so it
+/// must not outlive it, and after the result is no longer needed the
+/// memory of the whole parse can be freed in one step with
+/// `Arena::release`. Parsers run on other threads, such as by
+/// `parallel_many`, allocate from the heap instead.
+///
+/// ```
+/// Arena arena{};
+/// auto res = parse_with_arena(document, input, arena);
+/// use(*res);
+/// arena.release();
+/// ```
+static constexpr ParseWithArena parse_with_arena{};
+
+}
+
+#endif
@@ -0,0 +1,210 @@
+#ifndef CTPC_BINARY_OPS_HPP
+#define CTPC_BINARY_OPS_HPP
+
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "parser.hpp"
+#include "input.hpp"
+#include "parse_result.hpp"
+#include "utils.hpp"
+
+namespace ctpc {
+
+enum class Assoc {
+    left,
+    right,
+};
+
+template <typename P, typename F>
+struct BinaryOp {
+    size_t precedence;
+    Assoc assoc;
+    CTPC_NO_UNIQUE_ADDR P parser;
+    CTPC_NO_UNIQUE_ADDR F fold;
+};
+
+namespace detail {
+
+template <typename P, typename... Ops>
+struct BinaryOpsParser {
+  private:
+    CTPC_NO_UNIQUE_ADDR P operand_;
+    std::tuple<Ops...> ops_;
+
+    template <size_t IDX = 0, typename I>
+    constexpr bool match_op(I& input, size_t& op) const {
+        if constexpr (IDX == sizeof...(Ops)) {
+            return false;
+        } else {
+            auto res = std::get<IDX>(ops_).parser(input);
+            if (res) {
+                input = res.remaining();
+                op = IDX;
+                return true;
+            }
+            return match_op<IDX + 1>(input, op);
+        }
+    }
+
+    template <size_t IDX = 0>
+    constexpr size_t precedence(size_t op) const {
+        if constexpr (IDX + 1 == sizeof...(Ops)) {
+            return std::get<IDX>(ops_).precedence;
+        } else {
+            return op == IDX ? std::get<IDX>(ops_).precedence : precedence<IDX + 1>(op);
+        }
+    }
+
+    template <size_t IDX = 0>
+    constexpr Assoc assoc(size_t op) const {
+        if constexpr (IDX + 1 == sizeof...(Ops)) {
+            return std::get<IDX>(ops_).assoc;
+        } else {
+            return op == IDX ? std::get<IDX>(ops_).assoc : assoc<IDX + 1>(op);
+        }
+    }
+
+    template <size_t IDX = 0, typename T>
+    constexpr T apply(size_t op, T&& lhs, T&& rhs) const {
+        if constexpr (IDX + 1 == sizeof...(Ops)) {
+            return std::invoke(std::get<IDX>(ops_).fold, std::move(lhs), std::move(rhs));
+        } else {
+            if (op == IDX) {
+                return std::invoke(std::get<IDX>(ops_).fold, std::move(lhs), std::move(rhs));
+            }
+            return apply<IDX + 1>(op, std::move(lhs), std::move(rhs));
+        }
+    }
+
+    // Whether the pending operator `top` must be folded before `next` is
+    // pushed, i.e. whether `top` binds its right operand more tightly.
+    constexpr bool binds_tighter(size_t top, size_t next) const {
+        auto top_prec = precedence(top);
+        auto next_prec = precedence(next);
+        return top_prec > next_prec || (top_prec == next_prec && assoc(next) == Assoc::left);
+    }
+
+  public:
+    explicit constexpr BinaryOpsParser(P&& operand, Ops&&... ops)
+        : operand_(std::forward<P>(operand)),
+          ops_(std::forward<Ops>(ops)...) {}
+
+    template <ParseableBy<P> I>
+    constexpr auto operator()(I input) const {
+        using value_t = std::remove_cvref_t<typename std::remove_cvref_t<decltype(operand_(input))>::value_type>;
+
+        auto first = operand_(input);
+        if (!first) {
+            return fail<value_t>(input);
+        }
+
+        std::ranges::subrange in = first.remaining();
+        value_t curr = *std::move(first);
+        std::vector<value_t> values{};
+        std::vector<size_t> ops{};
+
+        for (;;) {
+            auto next = in;
+            size_t op = 0;
+            if (!match_op(next, op)) {
+                break;
+            }
+            auto rhs = operand_(next);
+            if (!rhs) {
+                break;
+            }
+
+            while (!ops.empty() && binds_tighter(ops.back(), op)) {
+                curr = apply(ops.back(), std::move(values.back()), std::move(curr));
+                values.pop_back();
+                ops.pop_back();
+            }
+
+            in = rhs.remaining();
+            values.push_back(std::move(curr));
+            ops.push_back(op);
+            curr = *std::move(rhs);
+        }
+
+        while (!ops.empty()) {
+            curr = apply(ops.back(), std::move(values.back()), std::move(curr));
+            values.pop_back();
+            ops.pop_back();
+        }
+
+        return pass<value_t>(in, std::move(curr));
+    }
+};
+
+}
+
+template <Assoc ASSOC>
+struct BinaryOpFactory {
+    template <typename P, typename F>
+    constexpr auto operator()(size_t precedence, P&& parser, F&& fold) const -> BinaryOp<P, F> {
+        return BinaryOp<P, F>{precedence, ASSOC, std::forward<P>(parser), std::forward<F>(fold)};
+    }
+};
+
+/// @brief Defines a left associative operator for `binary_ops`
+///
+/// @details
+/// `left_assoc(precedence, parser, fold)` describes a binary operator
+/// that is recognized by `parser` and combines its operands by calling
+/// `fold(lhs, rhs)`. Operators with a higher `precedence` bind more
+/// tightly. A chain such as `a - b - c` is folded as `(a - b) - c`.
+static constexpr BinaryOpFactory<Assoc::left> left_assoc{};
+
+/// @brief Defines a right associative operator for `binary_ops`
+///
+/// @details
+/// Same as `left_assoc`, except that a chain such as `a ^ b ^ c` is
+/// folded as `a ^ (b ^ c)`.
+static constexpr BinaryOpFactory<Assoc::right> right_assoc{};
+
+struct BinaryOps {
+    template <typename P, typename... Ops>
+        requires(sizeof...(Ops) > 0)
+    constexpr auto operator()(P&& operand, Ops&&... ops) const -> detail::BinaryOpsParser<P, Ops...> {
+        return detail::BinaryOpsParser<P, Ops...>(std::forward<P>(operand), std::forward<Ops>(ops)...);
+    }
+};
+
+/// @brief Parses operands separated by binary operators with precedence
+/// @ingroup ctpc_combinators
+///
+/// Combinator signature:
+/// ```
+/// binary_ops(Parser operand, BinaryOp ops...) -> T
+/// ```
+///
+/// Parses an `operand`, followed by any number of operator and `operand`
+/// pairs, and folds the operands into a single value of the operand's
+/// result type `T` according to the precedence and associativity of each
+/// operator (see `left_assoc` and `right_assoc`). Each operand is parsed
+/// exactly once, and folding is done iteratively, so long operator chains
+/// do not recurse. Operators are tried in the order they are passed, and
+/// the result of an operator's parser is discarded. If an operator is not
+/// followed by an operand, parsing stops before the operator. The parser
+/// fails only if the first operand fails.
+///
+/// ```
+/// static constexpr auto expr = binary_ops(
+///     number,
+///     left_assoc(1, plus, [](auto lhs, auto rhs) { return lhs + rhs; }),
+///     left_assoc(1, minus, [](auto lhs, auto rhs) { return lhs - rhs; }),
+///     left_assoc(2, star, [](auto lhs, auto rhs) { return lhs * rhs; }),
+///     right_assoc(3, caret, [](auto lhs, auto rhs) { return pow(lhs, rhs); })
+/// );
+/// ```
+static constexpr BinaryOps binary_ops{};
+
+}
+
+#endif
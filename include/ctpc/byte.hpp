@@ -13,7 +13,11 @@ struct Byte {
         auto i = std::ranges::begin(input);
         auto e = std::ranges::end(input);
         if (i == e) {
-            return fail<std::byte>(input);
+            if constexpr (StreamingInput<I>) {
+                return incomplete<std::byte>(input, 1);
+            } else {
+                return fail<std::byte>(input);
+            }
         } else {
             auto val = static_cast<std::byte>(*i);
             ++i;
@@ -5,6 +5,7 @@
 #include "input.hpp"
 #include "parse_result.hpp"
 #include "utils.hpp"
+#include "first_set.hpp"
 
 namespace ctpc {
 
@@ -19,6 +20,11 @@ struct CompleteParser {
     explicit constexpr CompleteParser(P&& parser)
         : parser_(std::forward<P>(parser)) {}
 
+    template <typename Elem>
+    static constexpr std::optional<FirstSet> first_set() {
+        return first_set_of<P, Elem>();
+    }
+
     constexpr auto operator()(Input auto input) const {
         auto res = parser_(input);
         if (res && !res.remaining().empty()) {
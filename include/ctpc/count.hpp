@@ -21,7 +21,7 @@ struct CountParser {
     template <ParseableBy<P> I>
     constexpr auto init() const {
         if constexpr (std::is_same_v<std::remove_cvref_t<T>, utils::DefaultReduceInit>) {
-            using item_t = decltype(parser_(std::declval<I>()));
+            using item_t = decltype(*parser_(std::declval<I>()));
             using accum_t = decltype(utils::invoke_unpacked(reduce_, utils::default_init, std::declval<item_t>()));
             if constexpr (utils::Reservable<accum_t>) {
                 accum_t accum{};
@@ -53,10 +53,10 @@ struct CountParser {
         for (size_t i = 0; i < count_; ++i) {
             auto res = parser_(in);
             if (!res) {
-                return fail<decltype(accum)>(input);
+                return fail<decltype(accum)>(input, res);
             }
             in = res.remaining();
-            accum = utils::invoke_unpacked(reduce_, std::move(accum), *std::move(res));
+            utils::reduce_into(reduce_, accum, *std::move(res));
         }
         return pass<decltype(accum)>(in, std::move(accum));
     }
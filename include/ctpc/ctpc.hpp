@@ -5,27 +5,42 @@
 #include "parse_result.hpp"
 #include "parser.hpp"
 #include "utils.hpp"
+#include "arena.hpp"
+#include "error.hpp"
 
 #include "alt.hpp"
+#include "binary_ops.hpp"
 #include "complete.hpp"
 #include "convert.hpp"
 #include "seq.hpp"
 #include "ignore.hpp"
 #include "integer.hpp"
+#include "number.hpp"
 #include "count.hpp"
 #include "static_count.hpp"
 #include "byte.hpp"
 #include "is_not.hpp"
 #include "many0.hpp"
 #include "many1.hpp"
+#include "separated_list.hpp"
+#include "parallel_many.hpp"
 #include "map.hpp"
+#include "memo.hpp"
 #include "flat_map.hpp"
+#include "length_prefixed.hpp"
 #include "verbatim.hpp"
+#include "keyword.hpp"
+#include "take.hpp"
 #include "regex_match.hpp"
+#include "lexer.hpp"
+#include "token.hpp"
 #include "preceded.hpp"
 #include "terminated.hpp"
 #include "delimited.hpp"
 #include "utf.hpp"
 #include "reinterpret.hpp"
+#include "record.hpp"
+#include "streaming.hpp"
+#include "mmap.hpp"
 
 #endif
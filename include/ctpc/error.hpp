@@ -0,0 +1,225 @@
+#ifndef CTPC_ERROR_HPP
+#define CTPC_ERROR_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "parser.hpp"
+#include "input.hpp"
+#include "parse_result.hpp"
+
+namespace ctpc {
+
+struct ParseWithErrors;
+
+/// @brief Records the furthest point a parse failed and what was expected
+/// there
+///
+/// @details
+/// A failed `ParseResult` only carries the input it was given, since `seq`,
+/// `alt` and most other combinators backtrack to their own input on
+/// failure. While installed by `parse_with_errors`, an `ErrorContext`
+/// instead collects every failure of a terminal parser such as `verbatim`
+/// or `regex_match`, and keeps the names of the terminals that failed at
+/// the furthest offset into the input. That offset is usually where the
+/// input stopped making sense, and the names are what would have let the
+/// parse continue.
+class ErrorContext {
+  private:
+    uintptr_t base_{0};
+    size_t offset_{0};
+    bool failed_{false};
+    std::vector<std::string_view> expected_{};
+
+    friend struct ParseWithErrors;
+
+  public:
+    /// @brief Whether any failure has been recorded
+    bool failed() const noexcept {
+        return failed_;
+    }
+
+    /// @brief The offset into the input, in elements, of the furthest
+    /// recorded failure
+    size_t offset() const noexcept {
+        return offset_;
+    }
+
+    /// @brief The names of the parsers that failed at `offset()`
+    ///
+    /// @details
+    /// Each name is listed once, in the order the failures happened. The
+    /// names refer to static storage and remain valid indefinitely.
+    std::span<const std::string_view> expected() const noexcept {
+        return expected_;
+    }
+
+    /// @brief Discards all recorded failures
+    void clear() noexcept {
+        offset_ = 0;
+        failed_ = false;
+        expected_.clear();
+    }
+
+    /// @brief Records that `name` was expected at `pos`, a pointer to an
+    /// element of `elem_size` bytes within the input of the current parse
+    void record(const void* pos, size_t elem_size, std::string_view name) {
+        auto addr = reinterpret_cast<uintptr_t>(pos);
+        if (addr < base_) {
+            return;
+        }
+        auto offset = static_cast<size_t>(addr - base_) / elem_size;
+        if (!failed_ || offset > offset_) {
+            offset_ = offset;
+            failed_ = true;
+            expected_.clear();
+        } else if (offset < offset_) {
+            return;
+        }
+        if (std::ranges::find(expected_, name) == expected_.end()) {
+            expected_.push_back(name);
+        }
+    }
+};
+
+namespace detail {
+
+// The error context installed on this thread by `parse_with_errors`, if
+// any.
+inline thread_local ErrorContext* current_error_context = nullptr;
+
+// Whether failures are being recorded by `parse_with_errors`.
+constexpr bool reporting_errors() {
+    return !std::is_constant_evaluated() && current_error_context != nullptr;
+}
+
+// Reports a failure to match `name` at the start of `input` to the current
+// error context. Only contiguous inputs are tracked, and nothing is done
+// when no context is installed, so the cost without `parse_with_errors`
+// is one thread local load on the failure path.
+template <typename I>
+constexpr void report_expected([[maybe_unused]] const I& input, [[maybe_unused]] std::string_view name) {
+    if constexpr (std::ranges::contiguous_range<I>) {
+        if (!std::is_constant_evaluated()) {
+            if (auto ctx = current_error_context; ctx != nullptr) [[unlikely]] {
+                ctx->record(std::ranges::data(input), sizeof(std::ranges::range_value_t<I>), name);
+            }
+        }
+    }
+}
+
+// Builds the text of an error name at compile time. `WRITE` is called
+// twice with an `ErrorNameWriter`, first to measure the name and then to
+// store it.
+struct ErrorNameWriter {
+    char* out{nullptr};
+    size_t size{0};
+
+    constexpr void put(char c) {
+        if (out != nullptr) {
+            out[size] = c;
+        }
+        ++size;
+    }
+
+    constexpr void put_utf8(uint32_t c) {
+        if (c < 0x80) {
+            put(static_cast<char>(c));
+        } else if (c < 0x800) {
+            put(static_cast<char>(0xC0 | (c >> 6)));
+            put(static_cast<char>(0x80 | (c & 0x3F)));
+        } else if (c < 0x10000) {
+            put(static_cast<char>(0xE0 | (c >> 12)));
+            put(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+            put(static_cast<char>(0x80 | (c & 0x3F)));
+        } else {
+            put(static_cast<char>(0xF0 | (c >> 18)));
+            put(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+            put(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+            put(static_cast<char>(0x80 | (c & 0x3F)));
+        }
+    }
+
+    constexpr void put_hex(uint32_t value, size_t digits) {
+        constexpr char hex[] = "0123456789abcdef";
+        while (digits-- != 0) {
+            put(hex[(value >> (digits * 4)) & 0xF]);
+        }
+    }
+};
+
+template <auto WRITE>
+inline constexpr size_t error_name_size = [] {
+    ErrorNameWriter writer{};
+    WRITE(writer);
+    return writer.size;
+}();
+
+template <auto WRITE>
+inline constexpr std::array<char, error_name_size<WRITE>> error_name_chars = [] {
+    std::array<char, error_name_size<WRITE>> ret{};
+    ErrorNameWriter writer{ret.data()};
+    WRITE(writer);
+    return ret;
+}();
+
+template <auto WRITE>
+inline constexpr std::string_view error_name{error_name_chars<WRITE>.data(), error_name_chars<WRITE>.size()};
+
+}
+
+struct ParseWithErrors {
+    template <typename P, Input I>
+        requires ParseableBy<I, P> && std::ranges::contiguous_range<I>
+    auto operator()(P&& parser, I input, ErrorContext& errors) const {
+        struct Scope {
+            ErrorContext* prev;
+
+            ~Scope() {
+                detail::current_error_context = prev;
+            }
+        } scope{std::exchange(detail::current_error_context, &errors)};
+        errors.clear();
+        errors.base_ = reinterpret_cast<uintptr_t>(std::ranges::data(input));
+        return parser(std::move(input));
+    }
+};
+
+/// @brief Runs a parser, recording where and why it failed
+///
+/// Signature:
+/// ```
+/// parse_with_errors(Parser parser, ContiguousInput input, ErrorContext& errors) -> ParseResult
+/// ```
+///
+/// Clears `errors` and installs it as the error context of the calling
+/// thread while `parser` runs. Terminal parsers that fail report their
+/// name and position to it, so that when the parse fails, or does not
+/// consume all of the input, `errors` holds the furthest offset at which a
+/// failure happened and what was expected there, without parsing the input
+/// a second time. Successful parses are not slowed down, and without
+/// `parse_with_errors` a failing terminal only checks that no context is
+/// installed. `verbatim` and `regex_match` report their failures. Parsers
+/// run on other threads, such as by `parallel_many`, do not report to
+/// `errors`.
+///
+/// ```
+/// ErrorContext errors{};
+/// auto res = parse_with_errors(message, input, errors);
+/// if (!res) {
+///     log_error(errors.offset(), errors.expected());
+/// }
+/// ```
+static constexpr ParseWithErrors parse_with_errors{};
+
+}
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef CTPC_FIRST_SET_HPP
+#define CTPC_FIRST_SET_HPP
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "input.hpp"
+
+namespace ctpc::detail {
+
+// The set of input elements that a parser may accept as its first element.
+// Elements are identified by their unsigned code unit value. All values
+// outside of the range [0, 256) are grouped together as "wide" values,
+// and are only tracked as a whole.
+class FirstSet {
+  private:
+    std::array<uint64_t, 4> bits_{};
+    bool wide_{false};
+
+  public:
+    constexpr FirstSet() = default;
+
+    constexpr void insert(uint32_t value) {
+        if (value < 256) {
+            bits_[value / 64] |= uint64_t{1} << (value % 64);
+        } else {
+            wide_ = true;
+        }
+    }
+
+    constexpr void insert(uint32_t first, uint32_t last) {
+        for (auto value = first; value <= last && value < 256; ++value) {
+            insert(value);
+        }
+        if (last >= 256) {
+            wide_ = true;
+        }
+    }
+
+    constexpr bool contains(uint32_t value) const {
+        if (value < 256) {
+            return ((bits_[value / 64] >> (value % 64)) & 1) != 0;
+        }
+        return wide_;
+    }
+
+    constexpr bool contains_wide() const {
+        return wide_;
+    }
+
+    constexpr FirstSet complement() const {
+        FirstSet ret{};
+        for (size_t i = 0; i < bits_.size(); ++i) {
+            ret.bits_[i] = ~bits_[i];
+        }
+        ret.wide_ = !wide_;
+        return ret;
+    }
+
+    constexpr FirstSet& operator|=(const FirstSet& other) {
+        for (size_t i = 0; i < bits_.size(); ++i) {
+            bits_[i] |= other.bits_[i];
+        }
+        wide_ = wide_ || other.wide_;
+        return *this;
+    }
+
+    constexpr bool operator==(const FirstSet&) const = default;
+};
+
+template <typename T>
+concept CodeUnit = std::same_as<T, std::byte> || (std::is_integral_v<T> && !std::is_same_v<T, bool>);
+
+template <CodeUnit T>
+constexpr uint32_t code_unit(T value) {
+    if constexpr (std::is_same_v<T, std::byte>) {
+        return std::to_integer<uint32_t>(value);
+    } else {
+        return static_cast<uint32_t>(static_cast<std::make_unsigned_t<T>>(value));
+    }
+}
+
+template <typename T>
+concept KindKey = CodeUnit<T> || std::is_enum_v<T>;
+
+template <KindKey T>
+constexpr uint32_t kind_key(T kind) {
+    if constexpr (std::is_enum_v<T> && !std::is_same_v<T, std::byte>) {
+        return code_unit(static_cast<std::underlying_type_t<T>>(kind));
+    } else {
+        return code_unit(kind);
+    }
+}
+
+// Elements that first sets can describe: code units, and tokens whose kind
+// is an integer or enumeration, which are identified by their kind.
+template <typename T>
+concept KeyedElement = CodeUnit<T> || (TokenElement<T> && KindKey<decltype(token_kind(std::declval<const T&>()))>);
+
+template <KeyedElement T>
+constexpr uint32_t element_key(const T& elem) {
+    if constexpr (CodeUnit<T>) {
+        return code_unit(elem);
+    } else {
+        return kind_key(token_kind(elem));
+    }
+}
+
+// A parser advertises its first set by providing a static member function
+// `first_set<Elem>()` returning `std::optional<FirstSet>`, where `Elem`
+// is the element type of the input. A first set may only be provided if
+// the parser never succeeds without consuming an element in the set.
+// `std::nullopt` means that nothing is known about the first element.
+template <typename P, typename Elem>
+concept HasFirstSet = requires {
+    { std::remove_cvref_t<P>::template first_set<Elem>() } -> std::same_as<std::optional<FirstSet>>;
+};
+
+template <typename P, typename Elem>
+constexpr std::optional<FirstSet> first_set_of() {
+    if constexpr (HasFirstSet<P, Elem>) {
+        return std::remove_cvref_t<P>::template first_set<Elem>();
+    } else {
+        return std::nullopt;
+    }
+}
+
+}
+
+#endif
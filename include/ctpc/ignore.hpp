@@ -4,6 +4,7 @@
 #include "parser.hpp"
 #include "input.hpp"
 #include "parse_result.hpp"
+#include "first_set.hpp"
 
 namespace ctpc {
 
@@ -18,6 +19,11 @@ struct IgnoreParser {
     explicit constexpr IgnoreParser(P&& parser)
         : parser_(std::forward<P>(parser)) {}
 
+    template <typename Elem>
+    static constexpr std::optional<FirstSet> first_set() {
+        return first_set_of<P, Elem>();
+    }
+
     constexpr auto operator()(ParseableBy<P> auto input) const {
         return parser_(input).map([] ([[maybe_unused]] auto&&... vals) -> void {});
     }
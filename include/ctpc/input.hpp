@@ -6,6 +6,7 @@
 #include <iterator>
 #include <ranges>
 #include <type_traits>
+#include <utility>
 
 namespace ctpc {
 
@@ -29,6 +30,105 @@ concept TextInput =
 template <typename T>
 concept ByteInput = InputOf<T, unsigned char> || InputOf<T, uint8_t> || InputOf<T, std::byte>;
 
+namespace detail {
+
+template <typename T>
+concept TokenWithKindMember = std::is_class_v<T> && requires(const T& token) {
+    token.kind;
+};
+
+template <typename T>
+concept TokenWithKindFunction = std::is_class_v<T> && requires(const T& token) {
+    token.kind();
+};
+
+}
+
+/// @brief An element of a pre-lexed token input
+///
+/// @details
+/// A token is a class with a `kind` data member or `kind()` member
+/// function, or an enumeration, in which case the token is its own kind.
+/// See `token_kind`.
+template <typename T>
+concept TokenElement = detail::TokenWithKindMember<T> || detail::TokenWithKindFunction<T> || std::is_enum_v<T>;
+
+/// @brief Gets the kind of a token
+template <TokenElement T>
+constexpr auto token_kind(const T& token) {
+    if constexpr (detail::TokenWithKindMember<T>) {
+        return token.kind;
+    } else if constexpr (detail::TokenWithKindFunction<T>) {
+        return token.kind();
+    } else {
+        return token;
+    }
+}
+
+template <typename T>
+concept TokenInput = Input<T> && TokenElement<std::remove_cvref_t<std::ranges::range_value_t<T>>>;
+
+/// @brief Sentinel marking the end of the data received so far
+///
+/// @details
+/// An input whose sentinel is a `StreamEnd` is a streaming input: its end
+/// is not the end of the data, only the end of what is currently
+/// available. Parsers that run out of a streaming input before they can
+/// decide whether to pass or fail return an incomplete result (see
+/// `ParseResult::incomplete`) instead of failing. `StreamEnd` compares and
+/// measures distances exactly like the sentinel it wraps.
+template <typename S>
+struct StreamEnd {
+    S end{};
+
+    template <typename It>
+        requires(!std::same_as<It, StreamEnd> && std::sentinel_for<S, It>)
+    friend constexpr bool operator==(const It& it, const StreamEnd& sentinel) {
+        return it == sentinel.end;
+    }
+
+    template <typename It>
+        requires(!std::same_as<It, StreamEnd> && std::sized_sentinel_for<S, It>)
+    friend constexpr auto operator-(const StreamEnd& sentinel, const It& it) {
+        return sentinel.end - it;
+    }
+
+    template <typename It>
+        requires(!std::same_as<It, StreamEnd> && std::sized_sentinel_for<S, It>)
+    friend constexpr auto operator-(const It& it, const StreamEnd& sentinel) {
+        return it - sentinel.end;
+    }
+};
+
+namespace detail {
+
+template <typename S>
+struct is_stream_end : std::false_type {};
+
+template <typename S>
+struct is_stream_end<StreamEnd<S>> : std::true_type {};
+
+}
+
+template <typename T>
+concept StreamingInput = Input<T> && detail::is_stream_end<std::ranges::sentinel_t<T>>::value;
+
+/// @brief Marks an input as streaming
+///
+/// @details
+/// Returns a view of `input` whose end is treated as the end of the data
+/// received so far rather than the end of the data. See `StreamEnd`.
+template <Input I>
+constexpr auto streaming_input(I&& input) {
+    auto begin = std::ranges::begin(input);
+    auto end = std::ranges::end(input);
+    if constexpr (StreamingInput<I>) {
+        return std::ranges::subrange(std::move(begin), std::move(end));
+    } else {
+        return std::ranges::subrange(std::move(begin), StreamEnd<decltype(end)>{std::move(end)});
+    }
+}
+
 }
 
 #endif
@@ -3,7 +3,10 @@
 
 #include <algorithm>
 #include <bit>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <ranges>
 #include <type_traits>
 
 #include "parser.hpp"
@@ -11,12 +14,41 @@
 #include "parse_result.hpp"
 #include "byte.hpp"
 #include "static_count.hpp"
+#include "simd.hpp"
 
 namespace ctpc {
 
 template <typename T>
 concept Integral = std::is_integral_v<T> && !std::is_same_v<T, bool>;
 
+namespace utils {
+
+/// @brief Reverses the bytes of an integer
+///
+/// @details
+/// Equivalent to C++23 `std::byteswap`, which is used when available.
+template <Integral T>
+constexpr T byteswap(T value) noexcept {
+#if defined(__cpp_lib_byteswap)
+    return std::byteswap(value);
+#else
+    if constexpr (sizeof(T) == 1) {
+        return value;
+    } else {
+        using U = std::make_unsigned_t<T>;
+        auto in = static_cast<U>(value);
+        U out = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            out = static_cast<U>((out << 8) | (in & 0xFF));
+            in = static_cast<U>(in >> 8);
+        }
+        return static_cast<T>(out);
+    }
+#endif
+}
+
+}
+
 template <Integral T, std::endian ENDIANNESS = std::endian::native>
 struct Integer {
     template <ByteInput I>
@@ -24,13 +56,33 @@ struct Integer {
         if constexpr (sizeof(T) == 1) {
             return byte(input).map([] (auto b) -> T { return static_cast<T>(b); });
         } else {
-            return static_count<sizeof(T)>(byte).map([] (const auto& bytes) {
+            if constexpr (std::ranges::contiguous_range<I> && std::ranges::sized_range<I>) {
+                if (!std::is_constant_evaluated()) {
+                    if (std::ranges::size(input) < sizeof(T)) {
+                        if constexpr (StreamingInput<I>) {
+                            return incomplete<T>(input, sizeof(T) - std::ranges::size(input));
+                        } else {
+                            return fail<T>(input);
+                        }
+                    }
+                    T value;
+                    std::memcpy(&value, std::ranges::data(input), sizeof(T));
+                    if constexpr (ENDIANNESS != std::endian::native) {
+                        value = utils::byteswap(value);
+                    }
+                    return pass<T>(
+                        std::ranges::subrange(std::ranges::next(std::ranges::begin(input), sizeof(T)), std::ranges::end(input)),
+                        value
+                    );
+                }
+            }
+            return static_count<sizeof(T)>(byte)(input).map([] (const auto& bytes) {
                 if constexpr (ENDIANNESS == std::endian::native) {
                     return std::bit_cast<T>(bytes);
                 } else {
                     std::array<std::byte, sizeof(T)> tmp{};
-                    std::ranges::reverse_copy(bytes, tmp);
-                    return std::bit_cast<T>(bytes);
+                    std::ranges::reverse_copy(bytes, tmp.begin());
+                    return std::bit_cast<T>(tmp);
                 }
             });
         }
@@ -107,6 +159,190 @@ static constexpr auto& int64_be = int64<std::endian::big>;
 /// @ingroup ctpc_parsers
 static constexpr auto& int64_le = int64<std::endian::little>;
 
+namespace detail {
+
+enum class Leb128Kind {
+    unsigned_,
+    signed_,
+    zigzag,
+};
+
+template <Integral T, Leb128Kind KIND>
+struct Leb128Traits {
+    static_assert(sizeof(T) <= 8, "LEB128 values are limited to 64 bits");
+    static_assert(KIND == Leb128Kind::unsigned_ ? std::is_unsigned_v<T> : std::is_signed_v<T>,
+                  "uleb128 requires an unsigned type, and sleb128 and zigzag_varint a signed type");
+
+    static constexpr size_t bits = sizeof(T) * 8;
+    // The longest encoding of a `T`
+    static constexpr size_t max_bytes = (bits + 6) / 7;
+    // Bits of the value held by the last byte of the longest encoding
+    static constexpr size_t last_bits = bits - 7 * (max_bytes - 1);
+
+    // Whether `last`, the final byte of an encoding of `n` bytes, leaves
+    // the value within `T`. Bits past the width of `T` must be zero, or for
+    // `sleb128`, copies of the sign bit.
+    static constexpr bool fits(uint8_t last, size_t n) {
+        if (n < max_bytes || last_bits == 7) {
+            return true;
+        }
+        auto payload = static_cast<uint32_t>(last & 0x7F);
+        if constexpr (KIND == Leb128Kind::signed_) {
+            auto upper = payload >> (last_bits - 1);
+            return upper == 0 || upper == (0x7Fu >> (last_bits - 1));
+        } else {
+            return (payload >> last_bits) == 0;
+        }
+    }
+
+    // Converts the payload of an `n` byte encoding ending in `last`
+    static constexpr T finish(uint64_t value, uint8_t last, size_t n) {
+        if constexpr (KIND == Leb128Kind::signed_) {
+            auto shift = 7 * n;
+            if (shift < 64 && (last & 0x40) != 0) {
+                value |= ~uint64_t{0} << shift;
+            }
+            return static_cast<T>(value);
+        } else if constexpr (KIND == Leb128Kind::zigzag) {
+            using U = std::make_unsigned_t<T>;
+            auto u = static_cast<U>(value);
+            return static_cast<T>(static_cast<U>(u >> 1) ^ static_cast<U>(-static_cast<U>(u & 1)));
+        } else {
+            return static_cast<T>(value);
+        }
+    }
+};
+
+// Packs the low 7 bits of each byte of a little endian word into the low
+// 56 bits, without a loop.
+constexpr uint64_t leb128_compact(uint64_t word) {
+    word &= 0x7F7F7F7F7F7F7F7F;
+    word = ((word & 0x7F007F007F007F00) >> 1) | (word & 0x007F007F007F007F);
+    word = ((word & 0x3FFF00003FFF0000) >> 2) | (word & 0x00003FFF00003FFF);
+    word = ((word & 0x0FFFFFFF00000000) >> 4) | (word & 0x000000000FFFFFFF);
+    return word;
+}
+
+}
+
+template <Integral T, detail::Leb128Kind KIND>
+struct Leb128 {
+  private:
+    using traits = detail::Leb128Traits<T, KIND>;
+
+  public:
+    template <ByteInput I>
+    constexpr auto operator()(I input) const -> ParseResultOf<T, I> {
+        auto begin = std::ranges::begin(input);
+        auto end = std::ranges::end(input);
+        auto it = begin;
+        uint64_t value = 0;
+        size_t n = 0;
+        if constexpr (std::ranges::contiguous_range<I> && std::ranges::sized_range<I> && sizeof(std::ranges::range_value_t<I>) == 1) {
+            if (!std::is_constant_evaluated() && std::ranges::size(input) >= 8) {
+                // The terminator is the first byte with a clear high bit
+                auto word = detail::simd::load<uint64_t>(std::ranges::data(input));
+                if constexpr (std::endian::native == std::endian::big) {
+                    word = utils::byteswap(word);
+                }
+                auto stops = ~word & 0x8080808080808080;
+                if (stops != 0) {
+                    n = static_cast<size_t>(std::countr_zero(stops)) / 8 + 1;
+                    auto last = static_cast<uint8_t>(word >> (8 * (n - 1)));
+                    if (n > traits::max_bytes || !traits::fits(last, n)) {
+                        return fail<T>(input);
+                    }
+                    if (n < 8) {
+                        word &= (uint64_t{1} << (8 * n)) - 1;
+                    }
+                    return pass<T>(
+                        std::ranges::subrange(std::ranges::next(begin, static_cast<std::ranges::range_difference_t<I>>(n)), end),
+                        traits::finish(detail::leb128_compact(word), last, n)
+                    );
+                }
+                if constexpr (traits::max_bytes <= 8) {
+                    return fail<T>(input);
+                }
+                value = detail::leb128_compact(word);
+                n = 8;
+                it = std::ranges::next(begin, 8);
+            }
+        }
+        while (true) {
+            if (n == traits::max_bytes) {
+                return fail<T>(input);
+            }
+            if (it == end) {
+                if constexpr (StreamingInput<I>) {
+                    return incomplete<T>(input, 1);
+                } else {
+                    return fail<T>(input);
+                }
+            }
+            auto b = static_cast<uint8_t>(static_cast<std::byte>(*it));
+            ++it;
+            value |= static_cast<uint64_t>(b & 0x7F) << (7 * n);
+            ++n;
+            if ((b & 0x80) == 0) {
+                if (!traits::fits(b, n)) {
+                    return fail<T>(input);
+                }
+                return pass<T>(std::ranges::subrange(it, end), traits::finish(value, b, n));
+            }
+        }
+    }
+};
+
+/// @brief Parses an unsigned LEB128 variable length integer
+/// @ingroup ctpc_parsers
+///
+/// Parser signature:
+/// ```
+/// uleb128<T> -> T
+/// ```
+///
+/// Each byte holds seven bits of the value, least significant first, and
+/// has its high bit set if more bytes follow, as in DWARF, WebAssembly and
+/// the varints of Protocol Buffers. Fails without consuming any input if
+/// the encoding is longer than the longest encoding of `T`, or if its
+/// value does not fit in `T`. Redundant trailing `0x80` bytes are accepted
+/// within that length. On a streaming input, ending before the last byte
+/// is incomplete.
+///
+/// Contiguous inputs with at least eight bytes remaining are decoded from
+/// a single 8 byte load, finding the last byte and packing the payload
+/// with bit operations instead of a loop per byte.
+template <Integral T = uint64_t>
+static constexpr Leb128<T, detail::Leb128Kind::unsigned_> uleb128{};
+
+/// @brief Parses a signed LEB128 variable length integer
+/// @ingroup ctpc_parsers
+///
+/// Parser signature:
+/// ```
+/// sleb128<T> -> T
+/// ```
+///
+/// Like `uleb128`, but the value is in two's complement and is sign
+/// extended from bit 6 of the last byte. In the longest encoding of `T`,
+/// the bits of the last byte past the width of `T` must match the sign.
+template <Integral T = int64_t>
+static constexpr Leb128<T, detail::Leb128Kind::signed_> sleb128{};
+
+/// @brief Parses a zigzag encoded variable length integer
+/// @ingroup ctpc_parsers
+///
+/// Parser signature:
+/// ```
+/// zigzag_varint<T> -> T
+/// ```
+///
+/// A `uleb128` of the same width holding the value zigzag encoded, so that
+/// small negative numbers are short: 0, -1, 1, -2 are encoded as 0, 1, 2,
+/// 3, as with the `sint32` and `sint64` types of Protocol Buffers.
+template <Integral T = int64_t>
+static constexpr Leb128<T, detail::Leb128Kind::zigzag> zigzag_varint{};
+
 }
 
 #endif
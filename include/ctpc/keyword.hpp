@@ -0,0 +1,309 @@
+#ifndef CTPC_KEYWORD_HPP
+#define CTPC_KEYWORD_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <ctll/fixed_string.hpp>
+
+#include "parser.hpp"
+#include "input.hpp"
+#include "parse_result.hpp"
+#include "first_set.hpp"
+#include "error.hpp"
+
+namespace ctpc {
+
+namespace detail {
+
+// Input code units 0 through 255, and one symbol for every wider unit
+static constexpr size_t keyword_symbols = 257;
+
+struct KeywordTrieBuild {
+    // Equivalence class of each symbol. Class 0 holds every symbol that
+    // does not occur in any literal.
+    std::array<uint16_t, keyword_symbols> classes{};
+    size_t class_count{1};
+    // Transitions, indexed by `state * class_count + class`. State 0 is
+    // the dead state and state 1 is the root.
+    std::vector<uint16_t> next{};
+    // Index of the accepted literal plus one, or zero
+    std::vector<uint16_t> accept{};
+};
+
+template <auto... LITERALS>
+constexpr KeywordTrieBuild keyword_build() {
+    KeywordTrieBuild trie{};
+
+    auto assign_classes = [&](const auto& literal) {
+        for (size_t i = 0; i < literal.size(); ++i) {
+            auto c = static_cast<uint32_t>(literal[i]);
+            if (c >= 0x80) {
+                compile_error("ctpc::one_of_literals: literals must be ASCII");
+            }
+            if (trie.classes[c] == 0) {
+                trie.classes[c] = static_cast<uint16_t>(trie.class_count++);
+            }
+        }
+    };
+    (assign_classes(LITERALS), ...);
+
+    trie.next.resize(2 * trie.class_count);
+    trie.accept.resize(2);
+    size_t index = 0;
+    auto insert = [&](const auto& literal) {
+        ++index;
+        size_t state = 1;
+        for (size_t i = 0; i < literal.size(); ++i) {
+            auto& slot = trie.next[state * trie.class_count + trie.classes[static_cast<uint32_t>(literal[i])]];
+            if (slot == 0) {
+                if (trie.accept.size() >= std::numeric_limits<uint16_t>::max()) {
+                    compile_error("ctpc::one_of_literals: too many literals");
+                }
+                slot = static_cast<uint16_t>(trie.accept.size());
+                trie.accept.push_back(0);
+                trie.next.resize(trie.next.size() + trie.class_count);
+            }
+            state = trie.next[state * trie.class_count + trie.classes[static_cast<uint32_t>(literal[i])]];
+        }
+        // An earlier duplicate of the same literal wins
+        if (trie.accept[state] == 0) {
+            trie.accept[state] = static_cast<uint16_t>(index);
+        }
+    };
+    (insert(LITERALS), ...);
+    return trie;
+}
+
+template <size_t STATES, size_t CLASSES>
+struct KeywordTrie {
+    std::array<uint16_t, keyword_symbols> classes{};
+    std::array<uint16_t, STATES * CLASSES> next{};
+    std::array<uint16_t, STATES> accept{};
+    // Whether any transition leaves each state
+    std::array<bool, STATES> open{};
+};
+
+template <typename I>
+struct KeywordMatch {
+    // Index of the matched literal plus one, or zero
+    size_t index;
+    std::ranges::iterator_t<I> end;
+    // Whether the end of a streaming input was reached while a longer
+    // literal could still match
+    bool incomplete;
+};
+
+template <ctll::fixed_string... LITERALS>
+struct KeywordSet {
+    static_assert(sizeof...(LITERALS) > 0, "one_of_literals requires at least one literal");
+
+    static constexpr auto size_info = [] {
+        auto trie = keyword_build<LITERALS...>();
+        return std::pair<size_t, size_t>{trie.accept.size(), trie.class_count};
+    }();
+
+    static constexpr size_t states = size_info.first;
+    static constexpr size_t classes = size_info.second;
+
+    static constexpr auto trie = [] {
+        auto build = keyword_build<LITERALS...>();
+        KeywordTrie<states, classes> ret{};
+        ret.classes = build.classes;
+        for (size_t i = 0; i < ret.next.size(); ++i) {
+            ret.next[i] = build.next[i];
+            if (build.next[i] != 0) {
+                ret.open[i / classes] = true;
+            }
+        }
+        for (size_t i = 0; i < ret.accept.size(); ++i) {
+            ret.accept[i] = build.accept[i];
+        }
+        return ret;
+    }();
+
+    template <typename T>
+    static constexpr size_t symbol(T unit) {
+        auto value = code_unit(unit);
+        return value < 256 ? value : 256;
+    }
+
+    template <typename Elem>
+    static constexpr std::optional<FirstSet> first_set() {
+        if constexpr (CodeUnit<Elem>) {
+            if (trie.accept[1] != 0) {
+                return std::nullopt;
+            }
+            FirstSet set{};
+            for (uint32_t sym = 0; sym < 256; ++sym) {
+                if (trie.next[classes + trie.classes[sym]] != 0) {
+                    set.insert(sym);
+                }
+            }
+            return set;
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    // Finds the longest literal at the start of `input`
+    template <typename I>
+    static constexpr KeywordMatch<I> match(I& input) {
+        using elem_t = std::remove_cvref_t<std::ranges::range_value_t<I>>;
+        auto begin = std::ranges::begin(input);
+        auto end = std::ranges::end(input);
+        size_t state = 1;
+        KeywordMatch<I> ret{trie.accept[1], begin, false};
+        for (auto it = begin;;) {
+            if (it == end) {
+                if constexpr (StreamingInput<I>) {
+                    ret.incomplete = trie.open[state];
+                }
+                break;
+            }
+            state = trie.next[state * classes + trie.classes[symbol(static_cast<elem_t>(*it))]];
+            if (state == 0) {
+                break;
+            }
+            ++it;
+            if (trie.accept[state] != 0) {
+                ret.index = trie.accept[state];
+                ret.end = it;
+            }
+        }
+        return ret;
+    }
+
+    template <ctll::fixed_string LITERAL>
+    static constexpr std::string_view error_name = detail::error_name<[](ErrorNameWriter& writer) {
+        writer.put('"');
+        for (size_t i = 0; i < LITERAL.size(); ++i) {
+            writer.put_utf8(static_cast<uint32_t>(LITERAL[i]));
+        }
+        writer.put('"');
+    }>;
+
+    template <typename I>
+    static constexpr void report_expected(const I& input) {
+        (detail::report_expected(input, error_name<LITERALS>), ...);
+    }
+};
+
+template <typename I>
+concept KeywordInput = Input<I> && CodeUnit<std::remove_cvref_t<std::ranges::range_value_t<I>>>;
+
+}
+
+template <ctll::fixed_string... LITERALS>
+struct OneOfLiterals {
+  private:
+    using set_t = detail::KeywordSet<LITERALS...>;
+
+  public:
+    template <typename Elem>
+    static constexpr std::optional<detail::FirstSet> first_set() {
+        return set_t::template first_set<Elem>();
+    }
+
+    template <detail::KeywordInput I>
+    constexpr auto operator()(I input) const {
+        using ret_t = std::ranges::subrange<std::ranges::iterator_t<I>>;
+        auto res = set_t::match(input);
+        if (res.incomplete) {
+            return incomplete<ret_t>(input, 1);
+        }
+        if (res.index == 0) {
+            if (detail::reporting_errors()) {
+                set_t::report_expected(input);
+            }
+            return fail<ret_t>(input);
+        }
+        return pass<ret_t>(std::ranges::subrange(res.end, std::ranges::end(input)), ret_t(std::ranges::begin(input), res.end));
+    }
+};
+
+/// @brief Matches the longest of several literals
+/// @ingroup ctpc_parsers
+///
+/// Parser signature:
+/// ```
+/// one_of_literals<Literal...> -> subrange
+/// ```
+///
+/// The literals are compiled into a trie at compile time, so the input is
+/// scanned once, one table lookup per element, instead of being compared
+/// against each literal in turn as with an `alt` of `verbatim` parsers.
+/// The result is the matched input. When several literals match, the
+/// longest one wins, so `"IN"` and `"INSERT"` may be listed in any order.
+/// Fails if no literal matches. On a streaming input, reaching the end
+/// while a longer literal could still match is incomplete.
+///
+/// Literals are compared against input code units, and must be ASCII.
+///
+/// ```
+/// static constexpr auto method = one_of_literals<"GET", "HEAD", "POST", "PUT", "DELETE">;
+/// ```
+template <ctll::fixed_string... LITERALS>
+static constexpr OneOfLiterals<LITERALS...> one_of_literals{};
+
+template <ctll::fixed_string... LITERALS>
+struct KeywordMap {
+  private:
+    using set_t = detail::KeywordSet<LITERALS...>;
+
+  public:
+    template <typename Elem>
+    static constexpr std::optional<detail::FirstSet> first_set() {
+        return set_t::template first_set<Elem>();
+    }
+
+    template <detail::KeywordInput I>
+    constexpr auto operator()(I input) const {
+        auto res = set_t::match(input);
+        if (res.incomplete) {
+            return incomplete<size_t>(input, 1);
+        }
+        if (res.index == 0) {
+            if (detail::reporting_errors()) {
+                set_t::report_expected(input);
+            }
+            return fail<size_t>(input);
+        }
+        return pass<size_t>(std::ranges::subrange(res.end, std::ranges::end(input)), res.index - 1);
+    }
+};
+
+/// @brief Matches the longest of several literals, returning its index
+/// @ingroup ctpc_parsers
+///
+/// Parser signature:
+/// ```
+/// keyword_map<Literal...> -> size_t
+/// ```
+///
+/// Like `one_of_literals`, but the result is the index of the matched
+/// literal, in the order the literals were given. Listing the literals in
+/// the order of an enumeration's values lets the index be converted to
+/// that enumeration directly.
+///
+/// ```
+/// enum class Method { get, head, post };
+///
+/// static constexpr auto method = map(
+///     keyword_map<"GET", "HEAD", "POST">,
+///     [](size_t index) { return static_cast<Method>(index); }
+/// );
+/// ```
+template <ctll::fixed_string... LITERALS>
+static constexpr KeywordMap<LITERALS...> keyword_map{};
+
+}
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef CTPC_LENGTH_PREFIXED_HPP
+#define CTPC_LENGTH_PREFIXED_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "parser.hpp"
+#include "input.hpp"
+#include "parse_result.hpp"
+#include "utils.hpp"
+#include "first_set.hpp"
+
+namespace ctpc {
+
+namespace detail {
+
+// The bounds of a frame following a length prefix. `needed` is nonzero if
+// the input is incomplete, and `passed` is false if the length failed to
+// parse or the input is too short.
+template <typename I>
+struct LengthPrefixedFrame {
+    std::ranges::iterator_t<I> begin;
+    std::ranges::iterator_t<I> end;
+    size_t needed;
+    bool passed;
+};
+
+// Parses a length with `len_parser`, then finds the end of that many
+// elements without visiting them when the input is random access.
+template <typename L, typename I>
+constexpr LengthPrefixedFrame<I> length_prefixed_frame(const L& len_parser, const I& input) {
+    auto len = len_parser(input);
+    auto end = std::ranges::end(input);
+    if (!len) {
+        return {std::ranges::begin(input), std::ranges::begin(input), len.needed(), false};
+    }
+
+    using len_t = std::remove_cvref_t<decltype(*len)>;
+    using diff_t = std::ranges::range_difference_t<I>;
+    static_assert(std::integral<len_t> && !std::same_as<len_t, bool>, "length_prefixed requires a length parser with an integer result");
+    auto value = *len;
+    if constexpr (std::is_signed_v<len_t>) {
+        if (value < 0) {
+            return {std::ranges::begin(input), std::ranges::begin(input), 0, false};
+        }
+    }
+    if (static_cast<std::make_unsigned_t<len_t>>(value) > static_cast<std::make_unsigned_t<diff_t>>(std::numeric_limits<diff_t>::max())) {
+        return {std::ranges::begin(input), std::ranges::begin(input), 0, false};
+    }
+
+    auto rem = len.remaining();
+    auto frame_begin = std::ranges::begin(rem);
+    auto frame_end = frame_begin;
+    auto missing = std::ranges::advance(frame_end, static_cast<diff_t>(value), end);
+    if (missing != 0) {
+        if constexpr (StreamingInput<I>) {
+            return {frame_begin, frame_begin, static_cast<size_t>(missing), false};
+        } else {
+            return {frame_begin, frame_begin, 0, false};
+        }
+    }
+    return {frame_begin, frame_end, 0, true};
+}
+
+template <typename L, typename P>
+struct LengthPrefixedParser {
+  private:
+    CTPC_NO_UNIQUE_ADDR L len_parser_;
+    CTPC_NO_UNIQUE_ADDR P parser_;
+
+  public:
+    constexpr LengthPrefixedParser(L&& len_parser, P&& parser)
+        : len_parser_(std::forward<L>(len_parser)),
+          parser_(std::forward<P>(parser)) {}
+
+    template <typename Elem>
+    static constexpr std::optional<FirstSet> first_set() {
+        return first_set_of<L, Elem>();
+    }
+
+    template <ParseableBy<L> I>
+        requires ParseableBy<std::ranges::subrange<std::ranges::iterator_t<I>>, P>
+    constexpr auto operator()(I input) const {
+        using frame_t = std::ranges::subrange<std::ranges::iterator_t<I>>;
+        using value_t = typename std::remove_cvref_t<decltype(parser_(std::declval<frame_t>()))>::value_type;
+        auto frame = length_prefixed_frame(len_parser_, input);
+        if (!frame.passed) {
+            if constexpr (StreamingInput<I>) {
+                if (frame.needed != 0) {
+                    return incomplete<value_t>(input, frame.needed);
+                }
+            }
+            return fail<value_t>(input);
+        }
+        // The frame ends at an iterator rather than the input's sentinel, so
+        // the parser sees an ordinary input even when `input` is streaming.
+        auto res = parser_(frame_t(frame.begin, frame.end));
+        if (!res) {
+            return fail<value_t>(input);
+        }
+        std::ranges::subrange rest(frame.end, std::ranges::end(input));
+        if constexpr (std::is_void_v<value_t>) {
+            return pass<value_t>(rest);
+        } else {
+            return pass<value_t>(rest, *std::move(res));
+        }
+    }
+};
+
+template <typename L>
+struct SkipLengthPrefixedParser {
+  private:
+    CTPC_NO_UNIQUE_ADDR L len_parser_;
+
+  public:
+    explicit constexpr SkipLengthPrefixedParser(L&& len_parser)
+        : len_parser_(std::forward<L>(len_parser)) {}
+
+    template <typename Elem>
+    static constexpr std::optional<FirstSet> first_set() {
+        return first_set_of<L, Elem>();
+    }
+
+    template <ParseableBy<L> I>
+    constexpr auto operator()(I input) const {
+        auto frame = length_prefixed_frame(len_parser_, input);
+        if (!frame.passed) {
+            if constexpr (StreamingInput<I>) {
+                if (frame.needed != 0) {
+                    return incomplete<void>(input, frame.needed);
+                }
+            }
+            return fail<void>(input);
+        }
+        return pass<void>(std::ranges::subrange(frame.end, std::ranges::end(input)));
+    }
+};
+
+}
+
+struct LengthPrefixed {
+    template <typename L, typename P>
+    constexpr auto operator()(L&& len_parser, P&& parser) const -> detail::LengthPrefixedParser<L, P> {
+        return {std::forward<L>(len_parser), std::forward<P>(parser)};
+    }
+};
+
+/// @brief Parses a length, then parses exactly that many elements
+/// @ingroup ctpc_combinators
+///
+/// Combinator signature:
+/// ```
+/// length_prefixed(Parser len_parser, Parser parser) -> T
+/// ```
+///
+/// Parses a length with `len_parser`, whose result must be an integer,
+/// and runs `parser` on a subrange of exactly that many of the following
+/// elements. The subrange refers to the original input, so nothing is
+/// copied, and `parser` cannot read past the end of the frame. The result
+/// is the result of `parser`, and the remaining input starts after the
+/// frame, even if `parser` did not consume all of it. Wrap `parser` in
+/// `complete` to require that it consumes the whole frame.
+///
+/// Fails if either parser fails, if the length is negative, or if fewer
+/// elements than the length remain. On a streaming input, a frame that is
+/// not yet fully available is incomplete, with the number of missing
+/// elements as `needed()`, and `parser` only ever sees whole frames. On
+/// random access inputs, finding the end of the frame takes constant time.
+///
+/// ```
+/// static constexpr auto record = length_prefixed(uint32_be, complete(fields));
+/// ```
+static constexpr LengthPrefixed length_prefixed{};
+
+struct SkipLengthPrefixed {
+    template <typename L>
+    constexpr auto operator()(L&& len_parser) const -> detail::SkipLengthPrefixedParser<L> {
+        return detail::SkipLengthPrefixedParser<L>(std::forward<L>(len_parser));
+    }
+};
+
+/// @brief Parses a length, then skips that many elements
+/// @ingroup ctpc_combinators
+///
+/// Combinator signature:
+/// ```
+/// skip_length_prefixed(Parser len_parser) -> void
+/// ```
+///
+/// Like `length_prefixed`, but the frame is skipped without being parsed
+/// at all, such as for an unknown or uninteresting record type.
+///
+/// ```
+/// static constexpr auto unknown_chunk = skip_length_prefixed(uint32_be);
+/// ```
+static constexpr SkipLengthPrefixed skip_length_prefixed{};
+
+}
+
+#endif
@@ -0,0 +1,585 @@
+#ifndef CTPC_LEXER_HPP
+#define CTPC_LEXER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <vector>
+
+#include "parser.hpp"
+#include "input.hpp"
+#include "parse_result.hpp"
+#include "first_set.hpp"
+#include "regex_match.hpp"
+
+namespace ctpc {
+
+/// @brief Result of a `lexer`
+///
+/// @details
+/// `token` is the index of the pattern that matched, in the order the
+/// patterns were given to `lexer`, and `text` is the matched input.
+template <typename R>
+struct Lexeme {
+    size_t token;
+    R text;
+};
+
+namespace detail {
+
+// Code units are grouped into 257 symbols: one for each value in [0, 256),
+// and one for all wider values, matching `FirstSet`.
+static constexpr size_t lexer_symbols = 257;
+
+constexpr bool lexer_set_contains(const FirstSet& set, size_t symbol) {
+    return symbol < 256 ? set.contains(static_cast<uint32_t>(symbol)) : set.contains_wide();
+}
+
+enum class LexerNodeKind {
+    empty,
+    set,
+    concat,
+    alt,
+    repeat,
+};
+
+struct LexerNode {
+    LexerNodeKind kind{LexerNodeKind::empty};
+    FirstSet set{};
+    std::vector<size_t> children{};
+    size_t min{0};
+    // `npos` for no upper bound
+    size_t max{0};
+};
+
+static constexpr size_t lexer_npos = std::numeric_limits<size_t>::max();
+
+// Recursive descent parser for the supported regex syntax: literals,
+// escapes, `.`, bracket expressions, groups, `|`, and the `*`, `+`, `?`
+// and `{m,n}` quantifiers.
+template <typename Regex>
+struct LexerRegexParser {
+    const Regex& regex;
+    size_t pos{0};
+    std::vector<LexerNode> nodes{};
+
+    constexpr bool at_end() const {
+        return pos == regex.size();
+    }
+
+    constexpr char32_t peek() const {
+        return regex[pos];
+    }
+
+    constexpr size_t add(LexerNode node) {
+        nodes.push_back(std::move(node));
+        return nodes.size() - 1;
+    }
+
+    constexpr size_t parse_number() {
+        size_t value = 0;
+        bool any = false;
+        while (!at_end() && peek() >= U'0' && peek() <= U'9') {
+            value = value * 10 + static_cast<size_t>(peek() - U'0');
+            ++pos;
+            any = true;
+        }
+        if (!any) {
+            compile_error("ctpc::lexer: expected a number in a {m,n} quantifier");
+        }
+        return value;
+    }
+
+    constexpr size_t parse_atom() {
+        auto c = regex[pos++];
+        LexerNode node{};
+        node.kind = LexerNodeKind::set;
+        if (c == U'(') {
+            if (pos + 1 < regex.size() && regex[pos] == U'?' && regex[pos + 1] == U':') {
+                pos += 2;
+            }
+            auto inner = parse_alt();
+            if (at_end() || peek() != U')') {
+                compile_error("ctpc::lexer: unbalanced parentheses");
+            }
+            ++pos;
+            return inner;
+        } else if (c == U'[') {
+            auto set = regex_class_set(regex, pos);
+            if (!set) {
+                compile_error("ctpc::lexer: unsupported bracket expression");
+            }
+            node.set = *set;
+        } else if (c == U'\\') {
+            if (at_end()) {
+                compile_error("ctpc::lexer: trailing backslash");
+            }
+            auto set = regex_escape_set(regex[pos++]);
+            if (!set) {
+                compile_error("ctpc::lexer: unsupported escape sequence");
+            }
+            node.set = *set;
+        } else if (c == U'.') {
+            FirstSet newline{};
+            newline.insert(U'\n');
+            node.set = newline.complement();
+        } else if (c >= 0x80) {
+            compile_error("ctpc::lexer: non-ASCII literals are not supported");
+        } else {
+            switch (c) {
+                case U')':
+                case U'*':
+                case U'+':
+                case U'?':
+                case U'{':
+                case U'}':
+                case U']':
+                case U'^':
+                case U'$':
+                    compile_error("ctpc::lexer: unexpected special character");
+                    break;
+                default:
+                    break;
+            }
+            node.set.insert(static_cast<uint32_t>(c));
+        }
+        return add(std::move(node));
+    }
+
+    constexpr size_t parse_repeat() {
+        auto atom = parse_atom();
+        while (!at_end()) {
+            auto c = peek();
+            size_t min = 0;
+            size_t max = lexer_npos;
+            if (c == U'*') {
+                ++pos;
+            } else if (c == U'+') {
+                ++pos;
+                min = 1;
+            } else if (c == U'?') {
+                ++pos;
+                max = 1;
+            } else if (c == U'{') {
+                ++pos;
+                min = parse_number();
+                max = min;
+                if (!at_end() && peek() == U',') {
+                    ++pos;
+                    max = !at_end() && peek() == U'}' ? lexer_npos : parse_number();
+                }
+                if (at_end() || peek() != U'}' || max < min) {
+                    compile_error("ctpc::lexer: invalid {m,n} quantifier");
+                }
+                ++pos;
+            } else {
+                break;
+            }
+            if (!at_end() && (peek() == U'?' || peek() == U'+')) {
+                compile_error("ctpc::lexer: lazy and possessive quantifiers are not supported");
+            }
+            LexerNode node{};
+            node.kind = LexerNodeKind::repeat;
+            node.children.push_back(atom);
+            node.min = min;
+            node.max = max;
+            atom = add(std::move(node));
+        }
+        return atom;
+    }
+
+    constexpr size_t parse_concat() {
+        LexerNode node{};
+        node.kind = LexerNodeKind::concat;
+        while (!at_end() && peek() != U'|' && peek() != U')') {
+            node.children.push_back(parse_repeat());
+        }
+        if (node.children.size() == 1) {
+            return node.children[0];
+        }
+        return add(std::move(node));
+    }
+
+    constexpr size_t parse_alt() {
+        LexerNode node{};
+        node.kind = LexerNodeKind::alt;
+        node.children.push_back(parse_concat());
+        while (!at_end() && peek() == U'|') {
+            ++pos;
+            node.children.push_back(parse_concat());
+        }
+        if (node.children.size() == 1) {
+            return node.children[0];
+        }
+        return add(std::move(node));
+    }
+};
+
+struct LexerNfaState {
+    // Transition on any symbol in `set` to `next`, if `has_set`
+    bool has_set{false};
+    FirstSet set{};
+    size_t next{0};
+    std::vector<size_t> eps{};
+    // Index of the pattern accepted in this state plus one, or zero
+    size_t accept{0};
+};
+
+struct LexerNfa {
+    std::vector<LexerNfaState> states{};
+
+    constexpr size_t add() {
+        states.emplace_back();
+        return states.size() - 1;
+    }
+
+    // Thompson construction of `node`. Returns the start and end states.
+    constexpr std::pair<size_t, size_t> compile(const std::vector<LexerNode>& nodes, size_t idx) {
+        const auto& node = nodes[idx];
+        switch (node.kind) {
+            case LexerNodeKind::empty: {
+                auto s = add();
+                return {s, s};
+            }
+            case LexerNodeKind::set: {
+                auto s = add();
+                auto e = add();
+                states[s].has_set = true;
+                states[s].set = node.set;
+                states[s].next = e;
+                return {s, e};
+            }
+            case LexerNodeKind::concat: {
+                auto s = add();
+                auto e = s;
+                for (auto child : node.children) {
+                    auto [cs, ce] = compile(nodes, child);
+                    states[e].eps.push_back(cs);
+                    e = ce;
+                }
+                return {s, e};
+            }
+            case LexerNodeKind::alt: {
+                auto s = add();
+                auto e = add();
+                for (auto child : node.children) {
+                    auto [cs, ce] = compile(nodes, child);
+                    states[s].eps.push_back(cs);
+                    states[ce].eps.push_back(e);
+                }
+                return {s, e};
+            }
+            case LexerNodeKind::repeat: {
+                auto s = add();
+                auto e = s;
+                for (size_t i = 0; i < node.min; ++i) {
+                    auto [cs, ce] = compile(nodes, node.children[0]);
+                    states[e].eps.push_back(cs);
+                    e = ce;
+                }
+                if (node.max == lexer_npos) {
+                    auto [cs, ce] = compile(nodes, node.children[0]);
+                    auto loop_end = add();
+                    states[e].eps.push_back(cs);
+                    states[e].eps.push_back(loop_end);
+                    states[ce].eps.push_back(cs);
+                    states[ce].eps.push_back(loop_end);
+                    e = loop_end;
+                } else {
+                    auto opt_end = add();
+                    for (size_t i = node.min; i < node.max; ++i) {
+                        auto [cs, ce] = compile(nodes, node.children[0]);
+                        states[e].eps.push_back(cs);
+                        states[e].eps.push_back(opt_end);
+                        e = ce;
+                    }
+                    states[e].eps.push_back(opt_end);
+                    e = opt_end;
+                }
+                return {s, e};
+            }
+        }
+        return {0, 0};
+    }
+};
+
+template <typename Regex>
+constexpr void lexer_add_pattern(LexerNfa& nfa, size_t start, const Regex& regex, size_t token) {
+    LexerRegexParser<Regex> parser{regex};
+    size_t root = 0;
+    if (regex.size() == 0) {
+        root = parser.add(LexerNode{});
+    } else {
+        root = parser.parse_alt();
+        if (!parser.at_end()) {
+            compile_error("ctpc::lexer: unbalanced parentheses");
+        }
+    }
+    auto [s, e] = nfa.compile(parser.nodes, root);
+    nfa.states[start].eps.push_back(s);
+    nfa.states[e].accept = token + 1;
+}
+
+struct LexerDfaBuild {
+    // Symbol to equivalence class
+    std::array<uint16_t, lexer_symbols> classes{};
+    size_t class_count{0};
+    // Row major transitions, `class_count` per state. State 0 is the dead
+    // state and state 1 is the start state.
+    std::vector<uint16_t> next{};
+    std::vector<size_t> accept{};
+};
+
+// Extends the sorted set of NFA states `set` with all states reachable from
+// it by epsilon transitions.
+constexpr void lexer_closure(const LexerNfa& nfa, std::vector<size_t>& set, std::vector<bool>& mark) {
+    std::vector<size_t> stack = set;
+    for (auto s : set) {
+        mark[s] = true;
+    }
+    while (!stack.empty()) {
+        auto s = stack.back();
+        stack.pop_back();
+        for (auto t : nfa.states[s].eps) {
+            if (!mark[t]) {
+                mark[t] = true;
+                set.push_back(t);
+                stack.push_back(t);
+            }
+        }
+    }
+    for (auto s : set) {
+        mark[s] = false;
+    }
+    std::sort(set.begin(), set.end());
+}
+
+template <auto... PATTERNS>
+constexpr LexerDfaBuild lexer_build() {
+    LexerNfa nfa{};
+    auto start = nfa.add();
+    size_t token = 0;
+    (lexer_add_pattern(nfa, start, PATTERNS, token++), ...);
+
+    LexerDfaBuild dfa{};
+
+    // Split the symbols into classes that no transition distinguishes.
+    std::vector<FirstSet> sets{};
+    for (const auto& state : nfa.states) {
+        if (state.has_set && std::find(sets.begin(), sets.end(), state.set) == sets.end()) {
+            sets.push_back(state.set);
+        }
+    }
+    for (const auto& set : sets) {
+        std::array<uint16_t, lexer_symbols> split{};
+        std::vector<int> ids(dfa.class_count * 2 + 2, -1);
+        size_t count = 0;
+        for (size_t sym = 0; sym < lexer_symbols; ++sym) {
+            auto key = dfa.classes[sym] * size_t{2} + (lexer_set_contains(set, sym) ? 1 : 0);
+            if (ids[key] < 0) {
+                ids[key] = static_cast<int>(count++);
+            }
+            split[sym] = static_cast<uint16_t>(ids[key]);
+        }
+        dfa.classes = split;
+        dfa.class_count = count;
+    }
+    if (dfa.class_count == 0) {
+        dfa.class_count = 1;
+    }
+    std::vector<size_t> representative(dfa.class_count, 0);
+    for (size_t sym = lexer_symbols; sym-- > 0;) {
+        representative[dfa.classes[sym]] = sym;
+    }
+
+    // Subset construction, with each DFA state identified by the sorted
+    // set of NFA states it stands for.
+    std::vector<std::vector<size_t>> subsets{};
+    auto find_or_add = [&](std::vector<size_t>&& subset) -> size_t {
+        for (size_t i = 0; i < subsets.size(); ++i) {
+            if (subsets[i].size() == subset.size() && subsets[i] == subset) {
+                return i;
+            }
+        }
+        size_t accept = 0;
+        for (auto s : subset) {
+            if (nfa.states[s].accept != 0 && (accept == 0 || nfa.states[s].accept < accept)) {
+                accept = nfa.states[s].accept;
+            }
+        }
+        subsets.push_back(std::move(subset));
+        dfa.accept.push_back(accept);
+        dfa.next.resize(dfa.next.size() + dfa.class_count, 0);
+        return subsets.size() - 1;
+    };
+
+    std::vector<bool> mark(nfa.states.size(), false);
+    find_or_add(std::vector<size_t>{});
+    std::vector<size_t> initial{start};
+    lexer_closure(nfa, initial, mark);
+    find_or_add(std::move(initial));
+
+    for (size_t d = 1; d < subsets.size(); ++d) {
+        for (size_t cls = 0; cls < dfa.class_count; ++cls) {
+            auto sym = representative[cls];
+            std::vector<size_t> target{};
+            for (auto s : subsets[d]) {
+                const auto& state = nfa.states[s];
+                if (state.has_set && !mark[state.next] && lexer_set_contains(state.set, sym)) {
+                    mark[state.next] = true;
+                    target.push_back(state.next);
+                }
+            }
+            if (target.empty()) {
+                continue;
+            }
+            for (auto s : target) {
+                mark[s] = false;
+            }
+            lexer_closure(nfa, target, mark);
+            auto id = find_or_add(std::move(target));
+            if (id > std::numeric_limits<uint16_t>::max()) {
+                compile_error("ctpc::lexer: too many DFA states");
+            }
+            dfa.next[d * dfa.class_count + cls] = static_cast<uint16_t>(id);
+        }
+    }
+    return dfa;
+}
+
+template <size_t STATES, size_t CLASSES>
+struct LexerDfa {
+    std::array<uint16_t, lexer_symbols> classes{};
+    std::array<uint16_t, STATES * CLASSES> next{};
+    // Index of the accepted pattern plus one, or zero
+    std::array<uint16_t, STATES> accept{};
+};
+
+}
+
+template <ctll::fixed_string... PATTERNS>
+struct Lexer {
+  private:
+    static constexpr auto size_info = [] {
+        auto dfa = detail::lexer_build<PATTERNS...>();
+        return std::pair<size_t, size_t>{dfa.accept.size(), dfa.class_count};
+    }();
+
+    static constexpr size_t states = size_info.first;
+    static constexpr size_t classes = size_info.second;
+
+    static constexpr auto dfa = [] {
+        auto build = detail::lexer_build<PATTERNS...>();
+        detail::LexerDfa<states, classes> ret{};
+        ret.classes = build.classes;
+        for (size_t i = 0; i < ret.next.size(); ++i) {
+            ret.next[i] = build.next[i];
+        }
+        for (size_t i = 0; i < ret.accept.size(); ++i) {
+            ret.accept[i] = static_cast<uint16_t>(build.accept[i]);
+        }
+        return ret;
+    }();
+
+    template <typename T>
+    static constexpr size_t symbol(T unit) {
+        auto value = static_cast<uint32_t>(static_cast<std::make_unsigned_t<T>>(unit));
+        return value < 256 ? value : 256;
+    }
+
+  public:
+    template <typename Elem>
+    static constexpr std::optional<detail::FirstSet> first_set() {
+        if constexpr (utils::is_text_char_v<Elem>) {
+            if (dfa.accept[1] != 0) {
+                return std::nullopt;
+            }
+            detail::FirstSet set{};
+            for (size_t sym = 0; sym < 256; ++sym) {
+                if (dfa.next[classes + dfa.classes[sym]] != 0) {
+                    set.insert(static_cast<uint32_t>(sym));
+                }
+            }
+            if (dfa.next[classes + dfa.classes[256]] != 0) {
+                set.insert(256);
+            }
+            return set;
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    template <TextInput I>
+    constexpr auto operator()(I input) const {
+        using elem_t = std::remove_cvref_t<std::ranges::range_value_t<I>>;
+        auto begin = std::ranges::begin(input);
+        auto end = std::ranges::end(input);
+        using ret_t = Lexeme<std::ranges::subrange<std::ranges::iterator_t<I>>>;
+
+        size_t state = 1;
+        size_t token = dfa.accept[1];
+        auto match_end = begin;
+        for (auto it = begin; it != end;) {
+            state = dfa.next[state * classes + dfa.classes[symbol(static_cast<elem_t>(*it))]];
+            if (state == 0) {
+                break;
+            }
+            ++it;
+            if (dfa.accept[state] != 0) {
+                token = dfa.accept[state];
+                match_end = it;
+            }
+        }
+
+        if (token == 0) {
+            return fail<ret_t>(input);
+        }
+        return pass<ret_t>(
+            std::ranges::subrange(match_end, end),
+            ret_t{token - 1, std::ranges::subrange(begin, match_end)}
+        );
+    }
+};
+
+/// @brief Matches the longest prefix of the input among several regexes
+/// @ingroup ctpc_parsers
+///
+/// Parser signature:
+/// ```
+/// lexer<Regex...> -> Lexeme<subrange>
+/// ```
+///
+/// All of the patterns are compiled together into a single deterministic
+/// automaton at compile time, so the input is scanned once no matter how
+/// many patterns there are, instead of once per pattern as with an `alt`
+/// of `regex_match` parsers. The result is a `Lexeme` holding the index
+/// of the pattern with the longest match, and the matched input. If
+/// several patterns match the same longest prefix, the first of them
+/// wins, so keywords can be listed before a general identifier pattern.
+/// Fails if no pattern matches.
+///
+/// Patterns are matched against input code units, and support literal
+/// ASCII characters, escapes such as `\d`, `\w` and `\s`, `.` (anything
+/// but a newline), bracket expressions, groups, `|`, and the greedy `*`,
+/// `+`, `?` and `{m,n}` quantifiers. Other syntax, such as anchors or
+/// backreferences, is a compile error.
+///
+/// ```
+/// static constexpr auto token = lexer<
+///     "if|else|while",
+///     "[a-zA-Z_]\\w*",
+///     "\\d+",
+///     "[-+*/=<>]=?"
+/// >;
+/// ```
+template <ctll::fixed_string... PATTERNS>
+static constexpr Lexer<PATTERNS...> lexer{};
+
+}
+
+#endif
@@ -10,19 +10,28 @@ namespace ctpc {
 
 namespace detail {
 
-template <typename P, typename R, typename T>
+template <typename P, typename R, typename T, typename H = utils::NoSizeHint>
 struct Many0Parser {
   private:
     CTPC_NO_UNIQUE_ADDR P parser_;
     CTPC_NO_UNIQUE_ADDR R reduce_;
     CTPC_NO_UNIQUE_ADDR T init_;
+    CTPC_NO_UNIQUE_ADDR H hint_;
+
+    static constexpr bool has_hint = !std::is_same_v<std::remove_cvref_t<H>, utils::NoSizeHint>;
 
     template <ParseableBy<P> I>
-    constexpr auto init() const {
+    constexpr auto init([[maybe_unused]] const I& input) const {
         if constexpr (std::is_same_v<std::remove_cvref_t<T>, utils::DefaultReduceInit>) {
             using item_t = decltype(*parser_(std::declval<I>()));
             using accum_t = decltype(utils::invoke_unpacked(reduce_, utils::default_init, std::declval<item_t>()));
-            return accum_t{};
+            accum_t accum{};
+            if constexpr (has_hint && utils::Reservable<accum_t>) {
+                accum.reserve(utils::size_hint(hint_, input));
+            }
+            return accum;
+        } else if constexpr (has_hint && std::invocable<T, size_t>) {
+            return init_(utils::size_hint(hint_, input));
         } else if constexpr (std::invocable<T>) {
             return init_();
         } else {
@@ -34,21 +43,33 @@ struct Many0Parser {
     constexpr Many0Parser(P&& parser, R&& reduce, T&& init)
         : parser_(std::forward<P>(parser)),
           reduce_(std::forward<R>(reduce)),
-          init_(std::forward<T>(init)) {}
+          init_(std::forward<T>(init)),
+          hint_() {}
+
+    constexpr Many0Parser(P&& parser, H&& hint, R&& reduce, T&& init)
+        : parser_(std::forward<P>(parser)),
+          reduce_(std::forward<R>(reduce)),
+          init_(std::forward<T>(init)),
+          hint_(std::forward<H>(hint)) {}
 
     constexpr auto operator()(Input auto input) const {
-        auto accum = init<decltype(input)>();
+        auto accum = init(input);
         std::ranges::subrange in{input};
         for (;;) {
             auto res = parser_(in);
             if (!res) {
+                if constexpr (StreamingInput<decltype(input)>) {
+                    // More input could extend the list
+                    if (res.incomplete()) {
+                        return incomplete<decltype(accum)>(input, res.needed());
+                    }
+                }
                 break;
             }
             in = res.remaining();
-            accum = utils::invoke_unpacked(reduce_, std::move(accum), *std::move(res));
+            utils::reduce_into(reduce_, accum, *std::move(res));
         }
         return pass<decltype(accum)>(in, std::move(accum));
-        return call(*this, input);
     }
 };
 
@@ -66,6 +87,40 @@ struct Many0 {
 /// @ingroup ctpc_combinators
 static constexpr Many0 many0{};
 
+struct Many0Sized {
+    template <typename P,
+              typename H,
+              typename R = const utils::DefaultReduce&,
+              typename T = const utils::DefaultReduceInit&>
+    constexpr auto operator()(P&& parser,
+                              H&& hint,
+                              R&& reduce = utils::default_reduce,
+                              T&& init = utils::default_reduce_init) const -> detail::Many0Parser<P, R, T, H> {
+        return detail::Many0Parser<P, R, T, H>(std::forward<P>(parser), std::forward<H>(hint), std::forward<R>(reduce), std::forward<T>(init));
+    }
+};
+
+/// @brief Like `many0`, but reserves room for the items up front
+/// @ingroup ctpc_combinators
+///
+/// Combinator signature:
+/// ```
+/// many0_sized(Parser parser, SizeHint hint, Reduce reduce = default_reduce, Init init = default_reduce_init) -> T
+/// ```
+///
+/// Before parsing, `hint(input)` is called to estimate the number of
+/// items in the input, which should be much cheaper than parsing them,
+/// such as counting separators with `utils::count_of`. With the default
+/// init, the accumulator is reserved to the estimate, and a custom `init`
+/// may take the estimate as an argument like with `count`. The estimate
+/// only affects allocation, not what is parsed, but an estimate far above
+/// the actual count wastes memory.
+///
+/// ```
+/// static constexpr auto lines = many0_sized(line, utils::count_of('\n'));
+/// ```
+static constexpr Many0Sized many0_sized{};
+
 }
 
 #endif
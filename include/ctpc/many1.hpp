@@ -5,24 +5,34 @@
 #include "input.hpp"
 #include "parse_result.hpp"
 #include "utils.hpp"
+#include "first_set.hpp"
 
 namespace ctpc {
 
 namespace detail {
 
-template <typename P, typename R, typename T>
+template <typename P, typename R, typename T, typename H = utils::NoSizeHint>
 struct Many1Parser {
   private:
     CTPC_NO_UNIQUE_ADDR P parser_;
     CTPC_NO_UNIQUE_ADDR R reduce_;
     CTPC_NO_UNIQUE_ADDR T init_;
+    CTPC_NO_UNIQUE_ADDR H hint_;
+
+    static constexpr bool has_hint = !std::is_same_v<std::remove_cvref_t<H>, utils::NoSizeHint>;
 
     template <ParseableBy<P> I>
-    constexpr auto init() const {
+    constexpr auto init([[maybe_unused]] const I& input) const {
         if constexpr (std::is_same_v<std::remove_cvref_t<T>, utils::DefaultReduceInit>) {
-            using item_t = decltype(parser_(std::declval<I>()));
+            using item_t = decltype(*parser_(std::declval<I>()));
             using accum_t = decltype(utils::invoke_unpacked(reduce_, utils::default_init, std::declval<item_t>()));
-            return accum_t{};
+            accum_t accum{};
+            if constexpr (has_hint && utils::Reservable<accum_t>) {
+                accum.reserve(utils::size_hint(hint_, input));
+            }
+            return accum;
+        } else if constexpr (has_hint && std::invocable<T, size_t>) {
+            return init_(utils::size_hint(hint_, input));
         } else if constexpr (std::invocable<T>) {
             return init_();
         } else {
@@ -34,30 +44,46 @@ struct Many1Parser {
     constexpr Many1Parser(P&& parser, R&& reduce, T&& init)
         : parser_(std::forward<P>(parser)),
           reduce_(std::forward<R>(reduce)),
-          init_(std::forward<T>(init)) {}
+          init_(std::forward<T>(init)),
+          hint_() {}
+
+    constexpr Many1Parser(P&& parser, H&& hint, R&& reduce, T&& init)
+        : parser_(std::forward<P>(parser)),
+          reduce_(std::forward<R>(reduce)),
+          init_(std::forward<T>(init)),
+          hint_(std::forward<H>(hint)) {}
+
+    template <typename Elem>
+    static constexpr std::optional<FirstSet> first_set() {
+        return first_set_of<P, Elem>();
+    }
 
     constexpr auto operator()(Input auto input) const {
-        std::optional<decltype(init<decltype(input)>())> accum = std::nullopt;
+        using accum_t = decltype(init(input));
         std::ranges::subrange in{input};
-        {
-            auto res = parser_(in);
-            if (!res) {
-                return fail<decltype(init<T>())>(in);
-            }
-            in = res.remaining();
-            accum = utils::invoke_unpacked(reduce_, init<T>(), *std::move(res));
+        auto first = parser_(in);
+        if (!first) {
+            return fail<accum_t>(input, first);
         }
+        in = first.remaining();
+        auto accum = init(input);
+        utils::reduce_into(reduce_, accum, *std::move(first));
 
         for (;;) {
             auto res = parser_(in);
             if (!res) {
+                if constexpr (StreamingInput<decltype(input)>) {
+                    if (res.incomplete()) {
+                        return incomplete<accum_t>(input, res.needed());
+                    }
+                }
                 break;
             }
             in = res.remaining();
-            accum = utils::invoke_unpacked(reduce_, *std::move(accum), *std::move(res));
+            utils::reduce_into(reduce_, accum, *std::move(res));
         }
 
-        return pass<decltype(accum)>(in, *std::move(accum));
+        return pass<accum_t>(in, std::move(accum));
     }
 };
 
@@ -75,6 +101,30 @@ struct Many1 {
 /// @ingroup ctpc_combinators
 static constexpr Many1 many1{};
 
+struct Many1Sized {
+    template <typename P,
+              typename H,
+              typename R = const utils::DefaultReduce&,
+              typename T = const utils::DefaultReduceInit&>
+    constexpr auto operator()(P&& parser,
+                              H&& hint,
+                              R&& reduce = utils::default_reduce,
+                              T&& init = utils::default_reduce_init) const -> detail::Many1Parser<P, R, T, H> {
+        return detail::Many1Parser<P, R, T, H>(std::forward<P>(parser), std::forward<H>(hint), std::forward<R>(reduce), std::forward<T>(init));
+    }
+};
+
+/// @brief Like `many1`, but reserves room for the items up front
+/// @ingroup ctpc_combinators
+///
+/// Combinator signature:
+/// ```
+/// many1_sized(Parser parser, SizeHint hint, Reduce reduce = default_reduce, Init init = default_reduce_init) -> T
+/// ```
+///
+/// See `many0_sized`.
+static constexpr Many1Sized many1_sized{};
+
 }
 
 #endif
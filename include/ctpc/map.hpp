@@ -5,6 +5,7 @@
 #include "input.hpp"
 #include "parse_result.hpp"
 #include "utils.hpp"
+#include "first_set.hpp"
 
 #include <tuple>
 
@@ -23,6 +24,11 @@ struct MapParser {
         : parser_(std::forward<P>(parser)),
           mapper_(std::forward<M>(mapper)) {}
 
+    template <typename Elem>
+    static constexpr std::optional<FirstSet> first_set() {
+        return first_set_of<P, Elem>();
+    }
+
     constexpr auto operator()(ParseableBy<P> auto input) const {
         return parser_(input).map([this] (auto&&... value) {
             return utils::invoke_unpacked(mapper_, std::forward<decltype(value)>(value)...);
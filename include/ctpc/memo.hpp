@@ -0,0 +1,449 @@
+#ifndef CTPC_MEMO_HPP
+#define CTPC_MEMO_HPP
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "parser.hpp"
+#include "input.hpp"
+#include "parse_result.hpp"
+#include "utils.hpp"
+#include "first_set.hpp"
+
+namespace ctpc {
+
+class MemoTable;
+
+namespace detail {
+
+// Each instantiation provides a unique address that identifies a
+// memoized parser (and the input type it was called with) in a MemoTable.
+template <typename P, typename I>
+struct MemoKey {
+    static inline char id{};
+};
+
+struct MemoEntryBase {
+    const void* key;
+    size_t pos;
+    void (*destroy)(MemoEntryBase*);
+    MemoEntryBase* next{nullptr};
+    MemoEntryBase* link{nullptr};
+
+    constexpr MemoEntryBase(const void* key, size_t pos, void (*destroy)(MemoEntryBase*))
+        : key(key),
+          pos(pos),
+          destroy(destroy) {}
+};
+
+template <typename R>
+struct MemoEntry : MemoEntryBase {
+    R result;
+
+    constexpr MemoEntry(const void* key, size_t pos, R&& result)
+        : MemoEntryBase(key, pos, &MemoEntry::destroy_entry),
+          result(std::move(result)) {}
+
+    static constexpr void destroy_entry(MemoEntryBase* entry) {
+        auto self = static_cast<MemoEntry*>(entry);
+        if (std::is_constant_evaluated()) {
+            delete self;
+        } else {
+            std::destroy_at(self);
+        }
+    }
+};
+
+}
+
+/// @brief Storage for the results of `memo` parsers
+///
+/// @details
+/// A `MemoTable` caches parse results keyed by parser identity and input
+/// position. A table is attached to an input with `memo_input`, and should
+/// only be used for a single input at a time. Calling `clear` discards all
+/// cached results so the table can be reused for another input, while
+/// retaining the memory allocated for previous parses.
+///
+/// At runtime, entries are allocated from an internal arena that is only
+/// released when the table is destroyed. During constant evaluation,
+/// entries are allocated individually and freed by `clear` or the
+/// destructor.
+class MemoTable {
+  private:
+    static constexpr size_t block_size = 64 * 1024;
+    static constexpr size_t min_buckets = 64;
+
+    struct Block {
+        std::byte* data;
+        size_t size;
+    };
+
+    std::vector<detail::MemoEntryBase*> buckets_{};
+    detail::MemoEntryBase* entries_{nullptr};
+    size_t count_{0};
+    std::vector<Block> blocks_{};
+    size_t block_idx_{0};
+    size_t block_used_{0};
+
+    constexpr size_t index(const void* key, size_t pos) const {
+        auto hash = static_cast<size_t>(pos * static_cast<size_t>(0x9E3779B97F4A7C15ull));
+        if (!std::is_constant_evaluated()) {
+            hash ^= reinterpret_cast<uintptr_t>(key) >> 4;
+        }
+        return hash & (buckets_.size() - 1);
+    }
+
+    constexpr void rehash(size_t size) {
+        std::vector<detail::MemoEntryBase*> buckets(size, nullptr);
+        buckets_.swap(buckets);
+        for (auto entry = entries_; entry != nullptr; entry = entry->link) {
+            auto& head = buckets_[index(entry->key, entry->pos)];
+            entry->next = head;
+            head = entry;
+        }
+    }
+
+    void* allocate(size_t size, size_t align) {
+        for (;;) {
+            if (block_idx_ < blocks_.size()) {
+                auto& block = blocks_[block_idx_];
+                void* ptr = block.data + block_used_;
+                size_t space = block.size - block_used_;
+                if (std::align(align, size, ptr, space) != nullptr) {
+                    block_used_ = block.size - space + size;
+                    return ptr;
+                }
+                ++block_idx_;
+                block_used_ = 0;
+            } else {
+                auto alloc_size = std::max(block_size, size + align);
+                blocks_.push_back(Block{static_cast<std::byte*>(::operator new(alloc_size)), alloc_size});
+            }
+        }
+    }
+
+  public:
+    constexpr MemoTable() = default;
+
+    MemoTable(const MemoTable&) = delete;
+    MemoTable& operator=(const MemoTable&) = delete;
+
+    constexpr ~MemoTable() {
+        clear();
+        if (!std::is_constant_evaluated()) {
+            for (auto& block : blocks_) {
+                ::operator delete(block.data);
+            }
+        }
+    }
+
+    /// @brief Returns the number of cached results
+    constexpr size_t size() const noexcept {
+        return count_;
+    }
+
+    /// @brief Discards all cached results
+    constexpr void clear() {
+        auto entry = entries_;
+        while (entry != nullptr) {
+            auto link = entry->link;
+            entry->destroy(entry);
+            entry = link;
+        }
+        entries_ = nullptr;
+        count_ = 0;
+        std::ranges::fill(buckets_, nullptr);
+        block_idx_ = 0;
+        block_used_ = 0;
+    }
+
+    template <typename R>
+    constexpr R* find(const void* key, size_t pos) const {
+        if (count_ == 0) {
+            return nullptr;
+        }
+        for (auto entry = buckets_[index(key, pos)]; entry != nullptr; entry = entry->next) {
+            if (entry->key == key && entry->pos == pos) {
+                return &static_cast<detail::MemoEntry<R>*>(entry)->result;
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename R>
+    constexpr R* insert(const void* key, size_t pos, R result) {
+        if ((count_ + 1) * 4 > buckets_.size() * 3) {
+            rehash(std::max(min_buckets, buckets_.size() * 2));
+        }
+
+        detail::MemoEntry<R>* entry = nullptr;
+        if (std::is_constant_evaluated()) {
+            entry = new detail::MemoEntry<R>(key, pos, std::move(result));
+        } else {
+            auto mem = allocate(sizeof(detail::MemoEntry<R>), alignof(detail::MemoEntry<R>));
+            entry = ::new (mem) detail::MemoEntry<R>(key, pos, std::move(result));
+        }
+
+        entry->link = entries_;
+        entries_ = entry;
+        auto& head = buckets_[index(key, pos)];
+        entry->next = head;
+        head = entry;
+        ++count_;
+        return &entry->result;
+    }
+};
+
+namespace detail {
+
+template <std::forward_iterator It>
+class MemoIterator {
+  private:
+    It it_{};
+    size_t pos_{0};
+    MemoTable* table_{nullptr};
+
+    static constexpr auto concept_tag() {
+        if constexpr (std::contiguous_iterator<It>) {
+            return std::contiguous_iterator_tag{};
+        } else if constexpr (std::random_access_iterator<It>) {
+            return std::random_access_iterator_tag{};
+        } else if constexpr (std::bidirectional_iterator<It>) {
+            return std::bidirectional_iterator_tag{};
+        } else {
+            return std::forward_iterator_tag{};
+        }
+    }
+
+  public:
+    using value_type = std::iter_value_t<It>;
+    using difference_type = std::iter_difference_t<It>;
+    using reference = std::iter_reference_t<It>;
+    using iterator_concept = decltype(concept_tag());
+    using iterator_category = std::forward_iterator_tag;
+
+    constexpr MemoIterator() = default;
+
+    constexpr MemoIterator(It it, size_t pos, MemoTable* table)
+        : it_(it),
+          pos_(pos),
+          table_(table) {}
+
+    constexpr const It& base() const noexcept {
+        return it_;
+    }
+
+    constexpr size_t position() const noexcept {
+        return pos_;
+    }
+
+    constexpr MemoTable* table() const noexcept {
+        return table_;
+    }
+
+    constexpr reference operator*() const {
+        return *it_;
+    }
+
+    constexpr auto operator->() const requires std::contiguous_iterator<It> {
+        return std::to_address(it_);
+    }
+
+    constexpr reference operator[](difference_type n) const requires std::random_access_iterator<It> {
+        return it_[n];
+    }
+
+    constexpr MemoIterator& operator++() {
+        ++it_;
+        ++pos_;
+        return *this;
+    }
+
+    constexpr MemoIterator operator++(int) {
+        auto ret = *this;
+        operator++();
+        return ret;
+    }
+
+    constexpr MemoIterator& operator--() requires std::bidirectional_iterator<It> {
+        --it_;
+        --pos_;
+        return *this;
+    }
+
+    constexpr MemoIterator operator--(int) requires std::bidirectional_iterator<It> {
+        auto ret = *this;
+        operator--();
+        return ret;
+    }
+
+    constexpr MemoIterator& operator+=(difference_type n) requires std::random_access_iterator<It> {
+        it_ += n;
+        pos_ = static_cast<size_t>(static_cast<difference_type>(pos_) + n);
+        return *this;
+    }
+
+    constexpr MemoIterator& operator-=(difference_type n) requires std::random_access_iterator<It> {
+        return *this += -n;
+    }
+
+    friend constexpr MemoIterator operator+(MemoIterator it, difference_type n) requires std::random_access_iterator<It> {
+        return it += n;
+    }
+
+    friend constexpr MemoIterator operator+(difference_type n, MemoIterator it) requires std::random_access_iterator<It> {
+        return it += n;
+    }
+
+    friend constexpr MemoIterator operator-(MemoIterator it, difference_type n) requires std::random_access_iterator<It> {
+        return it -= n;
+    }
+
+    friend constexpr difference_type operator-(const MemoIterator& lhs, const MemoIterator& rhs) requires std::sized_sentinel_for<It, It> {
+        return lhs.it_ - rhs.it_;
+    }
+
+    friend constexpr bool operator==(const MemoIterator& lhs, const MemoIterator& rhs) {
+        return lhs.it_ == rhs.it_;
+    }
+
+    friend constexpr auto operator<=>(const MemoIterator& lhs, const MemoIterator& rhs) requires std::random_access_iterator<It> {
+        return lhs.pos_ <=> rhs.pos_;
+    }
+
+    template <typename S>
+        requires(!std::same_as<S, It> && !std::same_as<S, MemoIterator> && std::sentinel_for<S, It>)
+    friend constexpr bool operator==(const MemoIterator& lhs, const S& rhs) {
+        return lhs.it_ == rhs;
+    }
+};
+
+template <typename T>
+struct is_memo_iterator : std::false_type {};
+
+template <typename It>
+struct is_memo_iterator<MemoIterator<It>> : std::true_type {};
+
+template <typename T>
+static inline constexpr bool is_memo_iterator_v = is_memo_iterator<T>::value;
+
+template <typename P>
+struct MemoParser {
+  private:
+    CTPC_NO_UNIQUE_ADDR P parser_;
+
+  public:
+    explicit constexpr MemoParser(P&& parser)
+        : parser_(std::forward<P>(parser)) {}
+
+    template <typename Elem>
+    static constexpr std::optional<FirstSet> first_set() {
+        return first_set_of<P, Elem>();
+    }
+
+    template <ParseableBy<P> I>
+    constexpr auto operator()(I input) const {
+        using res_t = std::remove_cvref_t<decltype(parser_(input))>;
+        if constexpr (is_memo_iterator_v<std::ranges::iterator_t<I>>) {
+            auto begin = std::ranges::begin(input);
+            auto table = begin.table();
+            if (table == nullptr) {
+                return res_t(parser_(input));
+            }
+
+            const void* key = &MemoKey<MemoParser, I>::id;
+            auto pos = begin.position();
+            if (auto cached = table->template find<res_t>(key, pos); cached != nullptr) {
+                return *cached;
+            }
+
+            // A failure is recorded before the parser runs, so that a
+            // left-recursive rule fails instead of recursing forever.
+            auto slot = table->template insert<res_t>(key, pos, fail<typename res_t::value_type>(input));
+            res_t res = parser_(input);
+            std::destroy_at(slot);
+            std::construct_at(slot, res);
+            return res;
+        } else {
+            return res_t(parser_(input));
+        }
+    }
+};
+
+}
+
+struct Memo {
+    template <typename P>
+    constexpr auto operator()(P&& parser) const -> detail::MemoParser<P> {
+        return detail::MemoParser<P>(std::forward<P>(parser));
+    }
+};
+
+/// @brief Caches the results of a parser by input position
+/// @ingroup ctpc_combinators
+///
+/// Combinator signature:
+/// ```
+/// memo(Parser parser) -> T
+/// ```
+///
+/// When the input was created by `memo_input`, the returned parser looks
+/// up the result of `parser` at the current input position in the
+/// attached `MemoTable` before running `parser`, and records the result
+/// afterwards. This guarantees that a rule is evaluated at most once per
+/// input position, turning backtracking grammars (such as a recursive
+/// `alt` of `seq`s sharing a common prefix) into linear time parsers.
+/// For any other input, `parser` is called directly.
+///
+/// Parsers are identified by type, so `memo` is intended to wrap named
+/// rules, such as those created with `CTPC_F`. Two `memo` parsers wrapping
+/// parsers of the same type share cache entries, which is only correct if
+/// they parse identically. Results must be copyable.
+///
+/// A memoized rule that is reentered at the same position before it has
+/// produced a result (i.e. left recursion) fails rather than recursing
+/// without bound.
+///
+/// ```
+/// template <Input I>
+/// constexpr ParseResultOf<int, I> expr_(I input);
+/// static constexpr auto expr = memo(CTPC_F(expr_));
+///
+/// MemoTable table;
+/// auto res = expr(memo_input(input, table));
+/// ```
+static constexpr Memo memo{};
+
+/// @brief Attaches a `MemoTable` to an input
+///
+/// @details
+/// Returns a view of `input` that carries a reference to `table` and
+/// tracks the position of each element, which is used by `memo` parsers
+/// to look up cached results. The view preserves the iterator category
+/// of `input`. The underlying iterators of the view and of any ranges
+/// parsed from it can be recovered with `base()`.
+template <Input I>
+constexpr auto memo_input(I input, MemoTable& table) {
+    using It = std::ranges::iterator_t<I>;
+    auto first = detail::MemoIterator<It>(std::ranges::begin(input), 0, &table);
+    if constexpr (std::ranges::common_range<I>) {
+        auto size = static_cast<size_t>(std::ranges::distance(input));
+        return std::ranges::subrange(first, detail::MemoIterator<It>(std::ranges::end(input), size, &table));
+    } else {
+        return std::ranges::subrange(first, std::ranges::end(input));
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef CTPC_MMAP_HPP
+#define CTPC_MMAP_HPP
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "parser.hpp"
+#include "input.hpp"
+#include "parse_result.hpp"
+
+#define CTPC_HAS_MMAP 1
+
+namespace ctpc {
+
+/// @brief A read-only memory mapping of a file
+///
+/// @details
+/// The mapping is owned by the `MappedFile` and released when it is
+/// destroyed, so it is not itself an input. Instead, `text()`, `bytes()`
+/// and `view<T>()` return contiguous, borrowed views of the file contents
+/// that can be passed to any parser, without copying the file into
+/// memory. The views are only valid for the lifetime of the `MappedFile`.
+class MappedFile {
+  private:
+    const std::byte* data_{nullptr};
+    size_t size_{0};
+
+    void unmap() noexcept {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<std::byte*>(data_), size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+    static size_t page_size() noexcept {
+        static const auto size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+    }
+
+  public:
+    MappedFile() = default;
+
+    /// @brief Maps the file at `path`
+    ///
+    /// @details
+    /// The kernel is advised that the file will be read sequentially.
+    /// Throws `std::system_error` if the file cannot be opened or mapped.
+    explicit MappedFile(const std::filesystem::path& path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "ctpc: failed to open " + path.string());
+        }
+        struct ::stat st {};
+        if (::fstat(fd, &st) != 0) {
+            auto err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::generic_category(), "ctpc: failed to stat " + path.string());
+        }
+        auto size = static_cast<size_t>(st.st_size);
+        if (size != 0) {
+            void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                auto err = errno;
+                ::close(fd);
+                throw std::system_error(err, std::generic_category(), "ctpc: failed to map " + path.string());
+            }
+            ::posix_madvise(addr, size, POSIX_MADV_SEQUENTIAL);
+            data_ = static_cast<const std::byte*>(addr);
+            size_ = size;
+        }
+        ::close(fd);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)) {}
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    ~MappedFile() {
+        unmap();
+    }
+
+    const std::byte* data() const noexcept {
+        return data_;
+    }
+
+    size_t size() const noexcept {
+        return size_;
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    /// @brief Views the file as a sequence of single byte elements `T`
+    template <typename T>
+        requires(sizeof(T) == 1 && std::is_trivially_copyable_v<T>)
+    std::span<const T> view() const noexcept {
+        return std::span<const T>(reinterpret_cast<const T*>(data_), size_);
+    }
+
+    /// @brief Views the file as text
+    std::string_view text() const noexcept {
+        return std::string_view(reinterpret_cast<const char*>(data_), size_);
+    }
+
+    /// @brief Views the file as bytes
+    std::span<const std::byte> bytes() const noexcept {
+        return view<std::byte>();
+    }
+
+    /// @brief Releases the pages that lie entirely before `offset`
+    ///
+    /// @details
+    /// Drops already parsed pages from the resident set. The contents are
+    /// unchanged, and are read from the file again if accessed later.
+    void discard(size_t offset) const noexcept {
+        auto end = std::min(offset, size_) / page_size() * page_size();
+        if (end != 0) {
+#if defined(MADV_DONTNEED)
+            ::madvise(const_cast<std::byte*>(data_), end, MADV_DONTNEED);
+#else
+            ::posix_madvise(const_cast<std::byte*>(data_), end, POSIX_MADV_DONTNEED);
+#endif
+        }
+    }
+};
+
+struct MmapInput {
+    MappedFile operator()(const std::filesystem::path& path) const {
+        return MappedFile(path);
+    }
+};
+
+/// @brief Memory maps a file for parsing
+///
+/// Signature:
+/// ```
+/// mmap_input(std::filesystem::path path) -> MappedFile
+/// ```
+///
+/// ```
+/// auto file = mmap_input("access.log");
+/// auto res = log_lines(file.text());
+/// ```
+static constexpr MmapInput mmap_input{};
+
+/// @brief Progress of `parse_each`
+struct ParseProgress {
+    /// @brief Input elements consumed so far
+    size_t consumed{0};
+    /// @brief Total input elements
+    size_t total{0};
+    /// @brief Number of values parsed so far
+    size_t count{0};
+    /// @brief Time spent parsing so far
+    std::chrono::steady_clock::duration elapsed{};
+
+    /// @brief Whether the whole input was consumed
+    bool done() const noexcept {
+        return consumed == total;
+    }
+
+    /// @brief Average throughput in input elements per second
+    double throughput() const noexcept {
+        auto seconds = std::chrono::duration<double>(elapsed).count();
+        return seconds > 0 ? static_cast<double>(consumed) / seconds : 0.0;
+    }
+};
+
+/// @brief Runs a parser repeatedly over a memory mapped file
+///
+/// Signature:
+/// ```
+/// parse_each<Elem = char>(const MappedFile& file, Parser parser, F on_value,
+///                         G on_progress = {}, size_t interval = 64 MiB) -> ParseProgress
+/// ```
+///
+/// Like `many0`, `parser` is run on the file contents repeatedly until it
+/// fails or the input is exhausted, but each value is handed to `on_value`
+/// rather than being accumulated, so memory use does not grow with the
+/// size of the file. Every `interval` elements, `on_progress` is called
+/// with the number of elements consumed and the throughput so far, and the
+/// pages that have been parsed are released from memory. A final progress
+/// report is made when parsing stops; use `ParseProgress::done` to check
+/// whether the whole file was parsed.
+///
+/// ```
+/// auto file = mmap_input("access.log");
+/// auto progress = parse_each(file, log_line, [&](auto line) { ingest(line); },
+///     [](const ParseProgress& p) { std::cerr << p.throughput() / 1e6 << " MB/s\n"; });
+/// ```
+template <typename Elem = char, typename P, typename F, typename G = void (*)(const ParseProgress&)>
+ParseProgress parse_each(const MappedFile& file,
+                         P&& parser,
+                         F&& on_value,
+                         G&& on_progress = [](const ParseProgress&) {},
+                         size_t interval = size_t{64} << 20) {
+    auto input = file.view<Elem>();
+    auto start = std::chrono::steady_clock::now();
+    ParseProgress progress{0, input.size(), 0, {}};
+    size_t next_report = interval;
+
+    std::span<const Elem> in = input;
+    while (!in.empty()) {
+        auto res = parser(in);
+        if (!res) {
+            break;
+        }
+        auto rem = res.remaining();
+        auto rem_begin = std::ranges::data(rem);
+        if (rem_begin == in.data()) {
+            // The parser consumed nothing, and would do so forever
+            break;
+        }
+        if constexpr (std::is_void_v<typename std::remove_cvref_t<decltype(res)>::value_type>) {
+            std::invoke(on_value);
+        } else {
+            std::invoke(on_value, *std::move(res));
+        }
+        in = std::span<const Elem>(rem_begin, std::ranges::size(rem));
+        ++progress.count;
+        progress.consumed = input.size() - in.size();
+        if (progress.consumed >= next_report) {
+            progress.elapsed = std::chrono::steady_clock::now() - start;
+            std::invoke(on_progress, std::as_const(progress));
+            file.discard(progress.consumed);
+            next_report = progress.consumed + interval;
+        }
+    }
+
+    progress.elapsed = std::chrono::steady_clock::now() - start;
+    std::invoke(on_progress, std::as_const(progress));
+    return progress;
+}
+
+}
+
+#endif
+
+#endif
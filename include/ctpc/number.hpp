@@ -0,0 +1,815 @@
+#ifndef CTPC_NUMBER_HPP
+#define CTPC_NUMBER_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "parser.hpp"
+#include "input.hpp"
+#include "parse_result.hpp"
+#include "first_set.hpp"
+#include "simd.hpp"
+#include "utf.hpp"
+
+namespace ctpc {
+
+namespace detail {
+
+template <typename I>
+concept NumberInput = Input<I> && CodeUnit<std::remove_cvref_t<std::ranges::range_value_t<I>>>;
+
+// Inputs whose digits are scanned and converted eight at a time, as bytes
+// packed into a 64-bit word
+template <typename I>
+concept SwarInput = NumberInput<I> &&
+                    std::ranges::contiguous_range<I> &&
+                    std::ranges::sized_range<I> &&
+                    sizeof(std::ranges::range_value_t<I>) == 1 &&
+                    std::endian::native == std::endian::little;
+
+inline constexpr uint64_t swar_ones = 0x0101'0101'0101'0101;
+
+// Sets the high bit of each byte of `x` that is not zero, and clears all
+// other bits.
+constexpr uint64_t swar_nonzero(uint64_t x) {
+    return (((x & (swar_ones * 0x7F)) + swar_ones * 0x7F) | x) & (swar_ones * 0x80);
+}
+
+// The number of leading bytes of `mask`, as produced by `swar_nonzero`,
+// that are zero.
+constexpr size_t swar_leading(uint64_t mask) {
+    return mask == 0 ? 8 : static_cast<size_t>(std::countr_zero(mask)) / 8;
+}
+
+template <unsigned BASE>
+struct Digits;
+
+template <>
+struct Digits<10> {
+    static constexpr int value(uint32_t unit) {
+        return unit >= '0' && unit <= '9' ? static_cast<int>(unit - '0') : -1;
+    }
+
+    // The number of decimal digits at the start of the eight characters
+    // packed in `word`
+    static constexpr size_t count(uint64_t word) {
+        auto x = word ^ (swar_ones * '0');
+        auto bad = (x & (swar_ones * 0xF0)) | (((x & (swar_ones * 0x0F)) + swar_ones * 0x06) & (swar_ones * 0xF0));
+        return swar_leading(swar_nonzero(bad));
+    }
+
+    // The value of the first `n` digits packed in `word`, where `n` is at
+    // least one
+    static constexpr uint64_t convert(uint64_t word, size_t n) {
+        auto x = word ^ (swar_ones * '0');
+        if (n < 8) {
+            x <<= 8 * (8 - n);
+        }
+        x = (x * 10 + (x >> 8)) & 0x00FF'00FF'00FF'00FF;
+        x = (x * 100 + (x >> 16)) & 0x0000'FFFF'0000'FFFF;
+        x = (x * 10000 + (x >> 32)) & 0xFFFF'FFFF;
+        return x;
+    }
+
+    static constexpr uint64_t scale(size_t n) {
+        constexpr uint64_t powers[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+        return powers[n];
+    }
+};
+
+template <>
+struct Digits<16> {
+    static constexpr int value(uint32_t unit) {
+        if (unit >= '0' && unit <= '9') {
+            return static_cast<int>(unit - '0');
+        } else if (unit >= 'a' && unit <= 'f') {
+            return static_cast<int>(unit - 'a' + 10);
+        } else if (unit >= 'A' && unit <= 'F') {
+            return static_cast<int>(unit - 'A' + 10);
+        }
+        return -1;
+    }
+
+    static constexpr size_t count(uint64_t word) {
+        auto x = word ^ (swar_ones * '0');
+        auto not_digit = (x & (swar_ones * 0xF0)) | (((x & (swar_ones * 0x0F)) + swar_ones * 0x06) & (swar_ones * 0xF0));
+        // Letters are folded to lower case, then mapped to 1 through 6
+        auto y = (word | (swar_ones * 0x20)) ^ (swar_ones * 0x60);
+        auto low = y & (swar_ones * 0x0F);
+        auto not_letter = (y & (swar_ones * 0xF0)) |
+                          ((low + swar_ones * 0x09) & (swar_ones * 0x10)) |
+                          (~(low + swar_ones * 0x0F) & (swar_ones * 0x10));
+        return swar_leading(swar_nonzero(not_digit) & swar_nonzero(not_letter));
+    }
+
+    static constexpr uint64_t convert(uint64_t word, size_t n) {
+        // Digits have the 0x40 bit clear and letters have it set
+        auto x = (word & (swar_ones * 0x0F)) + ((word >> 6) & swar_ones) * 9;
+        if (n < 8) {
+            x <<= 8 * (8 - n);
+        }
+        x = ((x << 4) | (x >> 8)) & 0x00FF'00FF'00FF'00FF;
+        x = ((x << 8) | (x >> 16)) & 0x0000'FFFF'0000'FFFF;
+        x = ((x << 16) | (x >> 32)) & 0xFFFF'FFFF;
+        return x;
+    }
+
+    static constexpr uint64_t scale(size_t n) {
+        return uint64_t{1} << (4 * n);
+    }
+};
+
+}
+
+template <std::integral T, unsigned BASE>
+struct TextInteger {
+  private:
+    static_assert(!std::is_same_v<T, bool>, "text integers cannot be bool");
+    static_assert(sizeof(T) <= sizeof(uint64_t), "text integers are limited to 64 bits");
+
+    using digits_t = detail::Digits<BASE>;
+
+    // `limit / BASE^n` for each limit and number of digits `n`, so that
+    // appending digits only divides at compile time
+    static constexpr auto quotients = [] {
+        std::array<std::array<uint64_t, 9>, 2> ret{};
+        for (size_t negative = 0; negative < 2; ++negative) {
+            auto limit = static_cast<uint64_t>(std::numeric_limits<T>::max()) + negative;
+            for (size_t n = 0; n < 9; ++n) {
+                ret[negative][n] = limit / digits_t::scale(n);
+            }
+        }
+        return ret;
+    }();
+
+    // Appends `n` digits with value `value` to `acc`, or returns false if
+    // the magnitude would not fit in `T`
+    static constexpr bool append(uint64_t& acc, uint64_t value, size_t n, bool negative) {
+        auto quotient = quotients[negative][n];
+        if (acc >= quotient) [[unlikely]] {
+            auto limit = static_cast<uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+            if (acc > quotient || value > limit - acc * digits_t::scale(n)) {
+                return false;
+            }
+        }
+        acc = acc * digits_t::scale(n) + value;
+        return true;
+    }
+
+  public:
+    template <typename Elem>
+    static constexpr std::optional<detail::FirstSet> first_set() {
+        if constexpr (detail::CodeUnit<Elem>) {
+            detail::FirstSet set{};
+            set.insert('0', '9');
+            if constexpr (BASE == 16) {
+                set.insert('a', 'f');
+                set.insert('A', 'F');
+            }
+            if constexpr (std::is_signed_v<T>) {
+                set.insert('-');
+            }
+            return set;
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    template <detail::NumberInput I>
+    constexpr auto operator()(I input) const {
+        using elem_t = std::remove_cvref_t<std::ranges::range_value_t<I>>;
+        auto begin = std::ranges::begin(input);
+        auto end = std::ranges::end(input);
+        auto it = begin;
+
+        bool negative = false;
+        if constexpr (std::is_signed_v<T>) {
+            if (it != end && detail::code_unit(static_cast<elem_t>(*it)) == '-') {
+                negative = true;
+                ++it;
+            }
+        }
+
+        uint64_t acc = 0;
+        bool any = false;
+        bool overflow = false;
+        bool scanned = false;
+        if constexpr (detail::SwarInput<I>) {
+            if (!std::is_constant_evaluated()) {
+                auto data = reinterpret_cast<const unsigned char*>(std::ranges::data(input));
+                auto size = static_cast<size_t>(std::ranges::size(input));
+                auto pos = static_cast<size_t>(it - begin);
+                while (size - pos >= 8) {
+                    auto word = detail::simd::load<uint64_t>(data + pos);
+                    auto n = digits_t::count(word);
+                    if (n == 0) {
+                        break;
+                    }
+                    any = true;
+                    if (!append(acc, digits_t::convert(word, n), n, negative)) {
+                        overflow = true;
+                        break;
+                    }
+                    pos += n;
+                    if (n < 8) {
+                        scanned = true;
+                        break;
+                    }
+                }
+                it = std::ranges::next(begin, static_cast<std::ranges::range_difference_t<I>>(pos));
+            }
+        }
+        if (!scanned && !overflow) {
+            for (; it != end; ++it) {
+                auto digit = digits_t::value(detail::code_unit(static_cast<elem_t>(*it)));
+                if (digit < 0) {
+                    break;
+                }
+                any = true;
+                if (!append(acc, static_cast<uint64_t>(digit), 1, negative)) {
+                    overflow = true;
+                    break;
+                }
+            }
+        }
+
+        if (overflow) {
+            return fail<T>(input);
+        }
+        if constexpr (StreamingInput<I>) {
+            if (it == end) {
+                return incomplete<T>(input, 1);
+            }
+        }
+        if (!any) {
+            return fail<T>(input);
+        }
+        auto value = negative ? static_cast<T>(uint64_t{0} - acc) : static_cast<T>(acc);
+        return pass<T>(std::ranges::subrange(it, end), value);
+    }
+};
+
+/// @brief Parses a decimal integer
+/// @ingroup ctpc_parsers
+///
+/// Parser signature:
+/// ```
+/// dec_int<T> -> T
+/// ```
+///
+/// Parses one or more decimal digits, preceded by an optional `-` when `T`
+/// is signed, and converts them to `T` in the same pass. Fails without
+/// consuming any input if there are no digits, or if the value does not
+/// fit in `T`. On contiguous inputs of single byte elements, the digits
+/// are validated and converted eight at a time with 64-bit arithmetic.
+/// On a streaming input, reaching the end of the input is incomplete,
+/// since more digits may follow.
+///
+/// ```
+/// static constexpr auto port = dec_int<uint16_t>;
+/// ```
+template <std::integral T>
+static constexpr TextInteger<T, 10> dec_int{};
+
+/// @brief Parses a hexadecimal integer
+/// @ingroup ctpc_parsers
+///
+/// Parser signature:
+/// ```
+/// hex_int<T> -> T
+/// ```
+///
+/// Like `dec_int`, but parses hexadecimal digits in either case, without a
+/// `0x` prefix.
+///
+/// ```
+/// static constexpr auto color = preceded(verbatim<"#">, hex_int<uint32_t>);
+/// ```
+template <std::integral T>
+static constexpr TextInteger<T, 16> hex_int{};
+
+namespace detail {
+
+// Arbitrary precision unsigned integer, used to convert decimal floating
+// point text exactly during constant evaluation
+class BigUint {
+  private:
+    // Little endian 32-bit limbs, without leading zero limbs
+    std::vector<uint32_t> limbs_{};
+
+    constexpr void trim() {
+        while (!limbs_.empty() && limbs_.back() == 0) {
+            limbs_.pop_back();
+        }
+    }
+
+  public:
+    constexpr BigUint() = default;
+
+    explicit constexpr BigUint(uint64_t value) {
+        while (value != 0) {
+            limbs_.push_back(static_cast<uint32_t>(value));
+            value >>= 32;
+        }
+    }
+
+    constexpr bool is_zero() const {
+        return limbs_.empty();
+    }
+
+    constexpr size_t bit_length() const {
+        if (limbs_.empty()) {
+            return 0;
+        }
+        return (limbs_.size() - 1) * 32 + static_cast<size_t>(std::bit_width(limbs_.back()));
+    }
+
+    constexpr bool bit(size_t index) const {
+        auto limb = index / 32;
+        return limb < limbs_.size() && ((limbs_[limb] >> (index % 32)) & 1) != 0;
+    }
+
+    // The value of bits `[index, index + 64)`
+    constexpr uint64_t bits(size_t index) const {
+        uint64_t ret = 0;
+        for (size_t i = 0; i < 64; ++i) {
+            if (bit(index + i)) {
+                ret |= uint64_t{1} << i;
+            }
+        }
+        return ret;
+    }
+
+    // Whether any of the bits below `index` are set
+    constexpr bool any_below(size_t index) const {
+        for (size_t i = 0; i < limbs_.size() && i * 32 < index; ++i) {
+            auto count = std::min<size_t>(32, index - i * 32);
+            auto mask = count == 32 ? ~uint32_t{0} : (uint32_t{1} << count) - 1;
+            if ((limbs_[i] & mask) != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    constexpr void mul_add(uint32_t mul, uint32_t add) {
+        uint64_t carry = add;
+        for (auto& limb : limbs_) {
+            auto value = uint64_t{limb} * mul + carry;
+            limb = static_cast<uint32_t>(value);
+            carry = value >> 32;
+        }
+        if (carry != 0) {
+            limbs_.push_back(static_cast<uint32_t>(carry));
+        }
+    }
+
+    constexpr void mul_pow10(size_t exp) {
+        for (; exp >= 9; exp -= 9) {
+            mul_add(1000000000, 0);
+        }
+        uint32_t rest = 1;
+        while (exp-- != 0) {
+            rest *= 10;
+        }
+        mul_add(rest, 0);
+    }
+
+    constexpr void shl(size_t count) {
+        if (limbs_.empty()) {
+            return;
+        }
+        limbs_.insert(limbs_.begin(), count / 32, 0);
+        count %= 32;
+        if (count != 0) {
+            uint32_t carry = 0;
+            for (auto& limb : limbs_) {
+                auto next = limb >> (32 - count);
+                limb = (limb << count) | carry;
+                carry = next;
+            }
+            if (carry != 0) {
+                limbs_.push_back(carry);
+            }
+        }
+    }
+
+    constexpr void shr1() {
+        for (size_t i = 0; i < limbs_.size(); ++i) {
+            limbs_[i] >>= 1;
+            if (i + 1 < limbs_.size()) {
+                limbs_[i] |= limbs_[i + 1] << 31;
+            }
+        }
+        trim();
+    }
+
+    constexpr bool operator>=(const BigUint& other) const {
+        if (limbs_.size() != other.limbs_.size()) {
+            return limbs_.size() > other.limbs_.size();
+        }
+        for (size_t i = limbs_.size(); i-- != 0;) {
+            if (limbs_[i] != other.limbs_[i]) {
+                return limbs_[i] > other.limbs_[i];
+            }
+        }
+        return true;
+    }
+
+    // Subtracts `other`, which must not be greater
+    constexpr void operator-=(const BigUint& other) {
+        int64_t borrow = 0;
+        for (size_t i = 0; i < limbs_.size(); ++i) {
+            auto value = int64_t{limbs_[i]} - borrow - (i < other.limbs_.size() ? int64_t{other.limbs_[i]} : 0);
+            borrow = value < 0 ? 1 : 0;
+            limbs_[i] = static_cast<uint32_t>(value + (borrow << 32));
+        }
+        trim();
+    }
+};
+
+// Rounds `q * 2^e2`, plus a nonzero fraction below the last bit of `q` if
+// `sticky`, to the nearest `T`, with ties to even. Returns `std::nullopt`
+// if the result overflows or underflows to zero.
+template <std::floating_point T>
+constexpr std::optional<T> float_round(uint64_t q, int64_t e2, bool sticky) {
+    constexpr int64_t precision = std::numeric_limits<T>::digits;
+    constexpr int64_t min_exp = std::numeric_limits<T>::min_exponent - 1;
+    constexpr int64_t max_exp = std::numeric_limits<T>::max_exponent - 1;
+
+    auto shift = std::countl_zero(q);
+    q <<= shift;
+    e2 -= shift;
+    auto lead = e2 + 63;
+    if (lead > max_exp) {
+        return std::nullopt;
+    }
+
+    auto keep = lead >= min_exp ? precision : precision - (min_exp - lead);
+    auto drop = 64 - keep;
+    if (drop > 64) {
+        return std::nullopt;
+    }
+    auto mant = drop == 64 ? 0 : q >> drop;
+    auto rem = drop == 64 ? q : q & ((uint64_t{1} << drop) - 1);
+    auto half = uint64_t{1} << (drop - 1);
+    if (rem > half || (rem == half && (sticky || (mant & 1) != 0))) {
+        ++mant;
+    }
+    if (mant == 0) {
+        return std::nullopt;
+    }
+    auto exp = e2 + drop;
+    // Rounding up may carry into the next power of two
+    if (mant == uint64_t{1} << precision) {
+        mant >>= 1;
+        ++exp;
+    }
+    if (exp + precision - 1 > max_exp) {
+        return std::nullopt;
+    }
+
+    auto ret = static_cast<T>(mant);
+    for (; exp > 0; --exp) {
+        ret *= 2;
+    }
+    for (; exp < 0; ++exp) {
+        ret /= 2;
+    }
+    return ret;
+}
+
+// Converts `digits * 10^exp10` to the nearest `T` exactly.
+template <std::floating_point T>
+constexpr std::optional<T> float_from_decimal(BigUint digits, int64_t exp10) {
+    if (exp10 >= 0) {
+        digits.mul_pow10(static_cast<size_t>(exp10));
+        auto length = digits.bit_length();
+        if (length <= 64) {
+            return float_round<T>(digits.bits(0), 0, false);
+        }
+        return float_round<T>(digits.bits(length - 64), static_cast<int64_t>(length - 64), digits.any_below(length - 64));
+    }
+
+    BigUint divisor{1};
+    divisor.mul_pow10(static_cast<size_t>(-exp10));
+    // Scale so that the quotient has 63 or 64 significant bits
+    auto k = static_cast<int64_t>(divisor.bit_length()) - static_cast<int64_t>(digits.bit_length()) + 63;
+    if (k >= 0) {
+        digits.shl(static_cast<size_t>(k));
+    } else {
+        divisor.shl(static_cast<size_t>(-k));
+    }
+    divisor.shl(63);
+    uint64_t q = 0;
+    for (int bit = 63; bit >= 0; --bit) {
+        if (digits >= divisor) {
+            digits -= divisor;
+            q |= uint64_t{1} << bit;
+        }
+        divisor.shr1();
+    }
+    return float_round<T>(q, -k, !digits.is_zero());
+}
+
+constexpr uint32_t float_lower(uint32_t unit) {
+    return unit >= 'A' && unit <= 'Z' ? unit + ('a' - 'A') : unit;
+}
+
+template <typename It>
+struct FloatScan {
+    // One past the last element of the number, or the start of the input
+    // if there is no number
+    It end;
+    bool valid;
+    // Whether the scan stopped at the end of the input
+    bool at_end;
+};
+
+// Finds the extent of a number in the format accepted by
+// `std::from_chars` with `std::chars_format::general`.
+template <typename Elem, typename It, typename S>
+constexpr FloatScan<It> float_scan(It begin, S end) {
+    auto unit = [](It it) { return code_unit(static_cast<Elem>(*it)); };
+    auto it = begin;
+    if (it != end && unit(it) == '-') {
+        ++it;
+    }
+    if (it == end) {
+        return {begin, false, true};
+    }
+
+    // Matches `word` case insensitively, returning how many elements of it
+    // were matched
+    auto match_word = [&](It& pos, std::string_view word) {
+        size_t i = 0;
+        while (i < word.size() && pos != end && float_lower(unit(pos)) == static_cast<uint32_t>(word[i])) {
+            ++pos;
+            ++i;
+        }
+        return i;
+    };
+
+    auto first = float_lower(unit(it));
+    if (first == 'i') {
+        if (match_word(it, "inf") != 3) {
+            return {begin, false, it == end};
+        }
+        auto longer = it;
+        auto matched = match_word(longer, "inity");
+        if (matched == 5) {
+            return {longer, true, false};
+        }
+        return {it, true, longer == end};
+    }
+    if (first == 'n') {
+        if (match_word(it, "nan") != 3) {
+            return {begin, false, it == end};
+        }
+        if (it == end || unit(it) != '(') {
+            return {it, true, it == end};
+        }
+        auto paren = it;
+        for (++paren; paren != end; ++paren) {
+            auto c = unit(paren);
+            if (c == ')') {
+                return {++paren, true, false};
+            }
+            if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_')) {
+                break;
+            }
+        }
+        return {it, true, paren == end};
+    }
+
+    bool any = false;
+    while (it != end && unit(it) >= '0' && unit(it) <= '9') {
+        ++it;
+        any = true;
+    }
+    if (it != end && unit(it) == '.') {
+        ++it;
+        while (it != end && unit(it) >= '0' && unit(it) <= '9') {
+            ++it;
+            any = true;
+        }
+    }
+    if (!any) {
+        return {begin, false, it == end};
+    }
+    if (it == end) {
+        return {it, true, true};
+    }
+    if (float_lower(unit(it)) != 'e') {
+        return {it, true, false};
+    }
+    auto exp = it;
+    ++exp;
+    if (exp != end && (unit(exp) == '-' || unit(exp) == '+')) {
+        ++exp;
+    }
+    bool exp_digits = false;
+    while (exp != end && unit(exp) >= '0' && unit(exp) <= '9') {
+        ++exp;
+        exp_digits = true;
+    }
+    if (!exp_digits) {
+        return {it, true, exp == end};
+    }
+    return {exp, true, exp == end};
+}
+
+// Converts a number found by `float_scan` to `T` with correct rounding,
+// without using any runtime facilities. Returns `std::nullopt` if the
+// value is out of range.
+template <std::floating_point T, typename Elem, typename It>
+constexpr std::optional<T> float_convert(It it, It end) {
+    auto unit = [](It pos) { return code_unit(static_cast<Elem>(*pos)); };
+    bool negative = false;
+    if (unit(it) == '-') {
+        negative = true;
+        ++it;
+    }
+    auto sign = [&](T value) { return negative ? -value : value; };
+
+    auto first = float_lower(unit(it));
+    if (first == 'i') {
+        return sign(std::numeric_limits<T>::infinity());
+    }
+    if (first == 'n') {
+        return sign(std::numeric_limits<T>::quiet_NaN());
+    }
+
+    BigUint digits{};
+    int64_t count = 0;
+    int64_t exp10 = 0;
+    bool fraction = false;
+    for (; it != end; ++it) {
+        auto c = unit(it);
+        if (c == '.') {
+            fraction = true;
+        } else if (c >= '0' && c <= '9') {
+            if (!digits.is_zero() || c != '0') {
+                digits.mul_add(10, c - '0');
+                ++count;
+            }
+            if (fraction) {
+                --exp10;
+            }
+        } else {
+            break;
+        }
+    }
+    if (it != end) {
+        ++it;
+        bool exp_negative = false;
+        if (unit(it) == '-' || unit(it) == '+') {
+            exp_negative = unit(it) == '-';
+            ++it;
+        }
+        int64_t exp = 0;
+        for (; it != end; ++it) {
+            exp = std::min<int64_t>(exp * 10 + (unit(it) - '0'), 1'000'000);
+        }
+        exp10 += exp_negative ? -exp : exp;
+    }
+
+    if (digits.is_zero()) {
+        return sign(T{0});
+    }
+    // The value lies in [10^(magnitude - 1), 10^magnitude)
+    auto magnitude = count + exp10;
+    if (magnitude > std::numeric_limits<T>::max_exponent10 + 1) {
+        return std::nullopt;
+    }
+    if (magnitude < std::numeric_limits<T>::min_exponent10 - std::numeric_limits<T>::max_digits10 - 2) {
+        return std::nullopt;
+    }
+    auto ret = float_from_decimal<T>(std::move(digits), exp10);
+    if (!ret) {
+        return std::nullopt;
+    }
+    return sign(*ret);
+}
+
+}
+
+template <std::floating_point T>
+struct TextFloat {
+  private:
+    static_assert(std::numeric_limits<T>::is_iec559 && std::numeric_limits<T>::digits <= 53,
+                  "float_ supports IEEE single and double precision");
+
+  public:
+    template <typename Elem>
+    static constexpr std::optional<detail::FirstSet> first_set() {
+        if constexpr (detail::CodeUnit<Elem>) {
+            detail::FirstSet set{};
+            set.insert('0', '9');
+            for (auto c : {'.', '-', 'i', 'I', 'n', 'N'}) {
+                set.insert(static_cast<uint32_t>(c));
+            }
+            return set;
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    template <detail::NumberInput I>
+    constexpr auto operator()(I input) const {
+        using elem_t = std::remove_cvref_t<std::ranges::range_value_t<I>>;
+        auto begin = std::ranges::begin(input);
+        auto end = std::ranges::end(input);
+
+        if constexpr (std::ranges::contiguous_range<I> && std::ranges::sized_range<I> &&
+                      sizeof(elem_t) == 1 && utils::is_text_char_v<elem_t> && !StreamingInput<I>) {
+            if (!std::is_constant_evaluated()) {
+                auto first = reinterpret_cast<const char*>(std::ranges::data(input));
+                auto last = first + std::ranges::size(input);
+                T value{};
+                auto [ptr, ec] = std::from_chars(first, last, value);
+                if (ec != std::errc{}) {
+                    return fail<T>(input);
+                }
+                auto it = std::ranges::next(begin, ptr - first);
+                return pass<T>(std::ranges::subrange(it, end), value);
+            }
+        }
+
+        auto scan = detail::float_scan<elem_t>(begin, end);
+        if constexpr (StreamingInput<I>) {
+            if (scan.at_end) {
+                return incomplete<T>(input, 1);
+            }
+        }
+        if (!scan.valid) {
+            return fail<T>(input);
+        }
+
+        std::optional<T> value{};
+        if (std::is_constant_evaluated()) {
+            value = detail::float_convert<T, elem_t>(begin, scan.end);
+        } else {
+            // The number is ASCII, so it can be narrowed for `from_chars`
+            std::string text{};
+            for (auto it = begin; it != scan.end; ++it) {
+                text.push_back(static_cast<char>(detail::code_unit(static_cast<elem_t>(*it))));
+            }
+            T result{};
+            auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), result);
+            if (ec == std::errc{}) {
+                value = result;
+            }
+        }
+        if (!value) {
+            return fail<T>(input);
+        }
+        return pass<T>(std::ranges::subrange(scan.end, end), *value);
+    }
+};
+
+/// @brief Parses a floating point number
+/// @ingroup ctpc_parsers
+///
+/// Parser signature:
+/// ```
+/// float_<T> -> T
+/// ```
+///
+/// Parses a number in the format accepted by `std::from_chars` with
+/// `std::chars_format::general`: an optional `-`, decimal digits with an
+/// optional fraction and exponent, or `inf`, `infinity` or `nan`. Unlike
+/// `std::strtod`, the format does not depend on the locale, and leading
+/// whitespace and `+` are not accepted. The result is correctly rounded.
+/// Fails without consuming any input if there is no number, or if its
+/// value is out of the range of `T`.
+///
+/// At runtime, contiguous `char` inputs are converted in place with
+/// `std::from_chars`. During constant evaluation, the number is converted
+/// exactly with arbitrary precision arithmetic. On a streaming input,
+/// reaching the end of the input is incomplete, since the number may
+/// continue.
+///
+/// ```
+/// static constexpr auto sample = seq(dec_int<uint64_t>, ignore(verbatim<" ">), float_<double>);
+/// ```
+template <std::floating_point T>
+static constexpr TextFloat<T> float_{};
+
+}
+
+#endif
@@ -0,0 +1,325 @@
+#ifndef CTPC_PARALLEL_MANY_HPP
+#define CTPC_PARALLEL_MANY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "parser.hpp"
+#include "input.hpp"
+#include "parse_result.hpp"
+#include "utils.hpp"
+
+namespace ctpc {
+
+namespace detail {
+
+template <typename T>
+struct SplitDelimiter {
+    T delim;
+
+    template <typename Elem>
+    constexpr size_t operator()(std::span<const Elem> input, size_t hint) const {
+        size_t pos = hint == 0 ? 0 : hint - 1;
+        if constexpr (sizeof(Elem) == 1 && std::is_trivially_copyable_v<Elem> &&
+                      requires(const T& d) { static_cast<unsigned char>(static_cast<Elem>(d)); }) {
+            if (!std::is_constant_evaluated()) {
+                // As with `utils::count_of`, a delimiter that no element can
+                // equal is never found
+                auto elem = static_cast<Elem>(delim);
+                if (pos >= input.size() || !(elem == delim)) {
+                    return input.size();
+                }
+                auto c = static_cast<unsigned char>(elem);
+                auto found = std::memchr(input.data() + pos, c, input.size() - pos);
+                if (found == nullptr) {
+                    return input.size();
+                }
+                return static_cast<size_t>(static_cast<const unsigned char*>(found) -
+                                           reinterpret_cast<const unsigned char*>(input.data())) + 1;
+            }
+        }
+        for (; pos < input.size(); ++pos) {
+            if (input[pos] == delim) {
+                return pos + 1;
+            }
+        }
+        return input.size();
+    }
+};
+
+template <typename P>
+struct SplitLengthPrefixed {
+    CTPC_NO_UNIQUE_ADDR P length_;
+
+    template <typename Elem>
+    constexpr size_t operator()(std::span<const Elem> input, size_t hint) const {
+        size_t pos = 0;
+        while (pos < hint && pos < input.size()) {
+            auto res = length_(input.subspan(pos));
+            if (!res) {
+                return input.size();
+            }
+            auto header = static_cast<size_t>(std::ranges::data(res.remaining()) - (input.data() + pos));
+            auto body = static_cast<size_t>(*res);
+            if (body > input.size() - pos - header) {
+                return input.size();
+            }
+            pos += header + body;
+        }
+        return std::min(pos, input.size());
+    }
+};
+
+template <typename P, typename S, typename R, typename T>
+struct ParallelManyParser {
+  private:
+    CTPC_NO_UNIQUE_ADDR P parser_;
+    CTPC_NO_UNIQUE_ADDR S splitter_;
+    CTPC_NO_UNIQUE_ADDR R reduce_;
+    CTPC_NO_UNIQUE_ADDR T init_;
+
+    // Inputs smaller than this per thread are not worth splitting.
+    static constexpr size_t min_chunk_size = size_t{1} << 16;
+
+    template <typename I>
+    using chunk_t = std::ranges::subrange<std::ranges::iterator_t<I>>;
+
+    template <typename I>
+    using item_t = std::remove_cvref_t<decltype(*std::declval<const P&>()(std::declval<chunk_t<I>>()))>;
+
+    template <typename I>
+    constexpr auto init(size_t count) const {
+        if constexpr (std::is_same_v<std::remove_cvref_t<T>, utils::DefaultReduceInit>) {
+            using accum_t = decltype(utils::invoke_unpacked(reduce_, utils::default_init, std::declval<item_t<I>>()));
+            accum_t accum{};
+            if constexpr (utils::Reservable<accum_t>) {
+                accum.reserve(count);
+            }
+            return accum;
+        } else if constexpr (std::invocable<T>) {
+            return init_();
+        } else {
+            return init_;
+        }
+    }
+
+    // Parses records from the start of `chunk` until it is exhausted or the
+    // parser fails, and returns the number of elements consumed.
+    template <typename I>
+    constexpr size_t parse_chunk(chunk_t<I> chunk, std::vector<item_t<I>>& items) const {
+        auto begin = std::ranges::begin(chunk);
+        std::ranges::subrange in = chunk;
+        while (!in.empty()) {
+            auto res = parser_(in);
+            if (!res) {
+                break;
+            }
+            auto rem = res.remaining();
+            if (std::ranges::begin(rem) == std::ranges::begin(in)) {
+                break;
+            }
+            items.push_back(*std::move(res));
+            in = chunk_t<I>(std::ranges::begin(rem), std::ranges::end(in));
+        }
+        return static_cast<size_t>(std::ranges::begin(in) - begin);
+    }
+
+  public:
+    constexpr ParallelManyParser(P&& parser, S&& splitter, R&& reduce, T&& init)
+        : parser_(std::forward<P>(parser)),
+          splitter_(std::forward<S>(splitter)),
+          reduce_(std::forward<R>(reduce)),
+          init_(std::forward<T>(init)) {}
+
+    template <Input I>
+        requires std::ranges::contiguous_range<I> && std::ranges::sized_range<I>
+    constexpr auto operator()(I input) const {
+        using elem_t = std::remove_cvref_t<std::ranges::range_value_t<I>>;
+        auto begin = std::ranges::begin(input);
+        auto size = static_cast<size_t>(std::ranges::size(input));
+        std::span<const elem_t> data(std::ranges::data(input), size);
+
+        // Chunk boundaries, each of which is a record boundary
+        std::vector<size_t> bounds{0};
+        if (!std::is_constant_evaluated()) {
+            size_t threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+            threads = std::min(threads, std::max<size_t>(size / min_chunk_size, 1));
+            size_t target = (size + threads - 1) / threads;
+            while (bounds.back() < size) {
+                auto last = bounds.back();
+                auto hint = std::min(target, size - last);
+                auto next = last + splitter_(data.subspan(last), hint);
+                bounds.push_back(std::max(next, last + 1));
+                bounds.back() = std::min(bounds.back(), size);
+            }
+        } else {
+            bounds.push_back(size);
+        }
+
+        size_t chunks = bounds.size() - 1;
+        std::vector<std::vector<item_t<I>>> items(chunks);
+        std::vector<size_t> consumed(chunks, 0);
+        auto run = [&](size_t idx) {
+            consumed[idx] = parse_chunk<I>(
+                chunk_t<I>(begin + static_cast<std::ptrdiff_t>(bounds[idx]),
+                           begin + static_cast<std::ptrdiff_t>(bounds[idx + 1])),
+                items[idx]
+            );
+        };
+
+        if (chunks <= 1 || std::is_constant_evaluated()) {
+            for (size_t i = 0; i < chunks; ++i) {
+                run(i);
+            }
+        } else {
+            std::vector<std::exception_ptr> errors(chunks);
+            std::vector<std::thread> workers{};
+            workers.reserve(chunks - 1);
+            auto run_caught = [&](size_t idx) {
+                try {
+                    run(idx);
+                } catch (...) {
+                    errors[idx] = std::current_exception();
+                }
+            };
+            // Chunks from `spawned` on run on this thread, which is all of
+            // them after the first that could not be given a thread.
+            size_t spawned = 1;
+            for (; spawned < chunks; ++spawned) {
+                try {
+                    workers.emplace_back([&, idx = spawned] { run_caught(idx); });
+                } catch (...) {
+                    break;
+                }
+            }
+            run_caught(0);
+            for (size_t i = spawned; i < chunks; ++i) {
+                run_caught(i);
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            for (auto& error : errors) {
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+            }
+        }
+
+        // Results are only kept up to the first chunk in which the parser
+        // stopped early, as if the whole input had been parsed in order.
+        size_t used = 0;
+        size_t count = 0;
+        size_t end = 0;
+        for (; used < chunks; ++used) {
+            count += items[used].size();
+            end = bounds[used] + consumed[used];
+            if (end != bounds[used + 1]) {
+                ++used;
+                break;
+            }
+        }
+
+        auto accum = init<I>(count);
+        for (size_t i = 0; i < used; ++i) {
+            for (auto& item : items[i]) {
+                utils::reduce_into(reduce_, accum, std::move(item));
+            }
+        }
+        return pass<decltype(accum)>(
+            std::ranges::subrange(begin + static_cast<std::ptrdiff_t>(end), std::ranges::end(input)),
+            std::move(accum)
+        );
+    }
+};
+
+}
+
+struct ParallelMany {
+    template <typename P,
+              typename S,
+              typename R = const utils::DefaultReduce&,
+              typename T = const utils::DefaultReduceInit&>
+    constexpr auto operator()(P&& parser,
+                              S&& splitter,
+                              R&& reduce = utils::default_reduce,
+                              T&& init = utils::default_reduce_init) const -> detail::ParallelManyParser<P, S, R, T> {
+        return detail::ParallelManyParser<P, S, R, T>(
+            std::forward<P>(parser),
+            std::forward<S>(splitter),
+            std::forward<R>(reduce),
+            std::forward<T>(init)
+        );
+    }
+};
+
+/// @brief Parses records of a large input on multiple threads
+/// @ingroup ctpc_combinators
+///
+/// Combinator signature:
+/// ```
+/// parallel_many(Parser parser, Splitter splitter, Reduce reduce = default_reduce, Init init = default_reduce_init) -> T
+/// ```
+///
+/// Produces the same result as `many0(parser, reduce, init)` on a
+/// contiguous input, but first divides the input into about one chunk per
+/// hardware thread and parses the chunks concurrently. Chunks are divided
+/// at record boundaries found by `splitter`, which must agree with where
+/// `parser` ends each record. Parsed values are then passed to `reduce` in
+/// input order on the calling thread. If `parser` stops before the end of
+/// a chunk, the values from later chunks are discarded, and the remaining
+/// input starts where it stopped. Small inputs, and inputs parsed during
+/// constant evaluation, are parsed on the calling thread, as are any
+/// chunks for which a thread could not be started.
+///
+/// A splitter is called as `splitter(std::span<const Elem> input, size_t
+/// hint)`, where `input` starts at a record boundary, and returns the
+/// first record boundary in `input` at or after `hint`, or the size of
+/// `input` if there is none. `split_on` and `split_length_prefixed`
+/// provide splitters for delimited and length prefixed records.
+///
+/// ```
+/// static constexpr auto lines = parallel_many(csv_line, split_on('\n'));
+/// ```
+static constexpr ParallelMany parallel_many{};
+
+struct SplitOn {
+    template <typename T>
+    constexpr auto operator()(T delim) const -> detail::SplitDelimiter<T> {
+        return detail::SplitDelimiter<T>{delim};
+    }
+};
+
+/// @brief Splitter for records that end with a delimiter element
+///
+/// @details
+/// Finds record boundaries just after the next `delim`, with `memchr`
+/// for single byte elements, without looking at the records in between.
+static constexpr SplitOn split_on{};
+
+struct SplitLengthPrefixed {
+    template <typename P>
+    constexpr auto operator()(P&& length) const -> detail::SplitLengthPrefixed<P> {
+        return detail::SplitLengthPrefixed<P>{std::forward<P>(length)};
+    }
+};
+
+/// @brief Splitter for records that start with their length
+///
+/// @details
+/// `length` parses the prefix of a record and returns the number of
+/// elements that follow it in the record, such as `uint32_be`. Record
+/// boundaries are found by skipping from one prefix to the next.
+static constexpr SplitLengthPrefixed split_length_prefixed{};
+
+}
+
+#endif
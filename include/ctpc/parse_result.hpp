@@ -15,17 +15,25 @@ struct failure_t {};
 
 static inline constexpr failure_t failure{};
 
+// Failure due to the end of a streaming input, where at least `needed`
+// more input elements are required to decide the parse. An `incomplete_t`
+// with `needed == 0` is an ordinary failure.
+struct incomplete_t {
+    size_t needed;
+};
+
 template <typename T, std::forward_iterator First, std::sentinel_for<First> Last = First>
 class ParseResult {
   private:
     utils::Maybe<T> value_;
     std::ranges::subrange<First, Last> rem_;
+    size_t needed_{0};
 
     template <typename, std::forward_iterator F, std::sentinel_for<F> L>
     friend class ParseResult;
 
     template <typename U, typename M>
-    static constexpr auto map(U&& value, std::ranges::subrange<First, Last> rem, M&& mapper) {
+    static constexpr auto map(U&& value, std::ranges::subrange<First, Last> rem, size_t needed, M&& mapper) {
         if constexpr (std::is_void_v<T>) {
             using ret_t = decltype(mapper());
             if (value.has_value()) {
@@ -36,7 +44,7 @@ class ParseResult {
                     return ParseResult<ret_t, First, Last>{rem, mapper()};
                 }
             } else {
-                return ParseResult<ret_t, First, Last>{rem, failure};
+                return ParseResult<ret_t, First, Last>{rem, incomplete_t{needed}};
             }
         } else {
             using ret_t = decltype(mapper(*std::forward<U>(value)));
@@ -48,7 +56,7 @@ class ParseResult {
                     return ParseResult<ret_t, First, Last>{rem, mapper(*std::forward<U>(value))};
                 }
             } else {
-                return ParseResult<ret_t, First, Last>{rem, failure};
+                return ParseResult<ret_t, First, Last>{rem, incomplete_t{needed}};
             }
         }
     }
@@ -79,17 +87,24 @@ class ParseResult {
         : value_(utils::none),
           rem_(remaining) {}
 
+    constexpr ParseResult(std::ranges::subrange<First, Last> remaining, incomplete_t incomplete)
+        : value_(utils::none),
+          rem_(remaining),
+          needed_(incomplete.needed) {}
+
     template <typename U, typename F, typename L>
     explicit(!std::is_convertible_v<U, T> || !std::is_convertible_v<F, First> || !std::is_convertible_v<L, Last>)
     constexpr ParseResult(const ParseResult<U, F, L>& other)
         : value_(other.value_),
-          rem_(std::ranges::begin(other.rem_), std::ranges::end(other.rem_)) {}
+          rem_(std::ranges::begin(other.rem_), std::ranges::end(other.rem_)),
+          needed_(other.needed_) {}
 
     template <typename U, typename F, typename L>
     explicit(!std::is_convertible_v<U, T> || !std::is_convertible_v<F, First> || !std::is_convertible_v<L, Last>)
     constexpr ParseResult(ParseResult<U, F, L>&& other)
         : value_(std::move(other.value_)),
-          rem_(std::ranges::begin(other.rem_), std::ranges::end(other.rem_)) {}
+          rem_(std::ranges::begin(other.rem_), std::ranges::end(other.rem_)),
+          needed_(other.needed_) {}
 
     constexpr bool passed() const noexcept {
         return value_.has_value();
@@ -103,6 +118,19 @@ class ParseResult {
         return passed();
     }
 
+    /// @brief Whether the parse failed because a streaming input ended early
+    constexpr bool incomplete() const noexcept {
+        return needed_ != 0;
+    }
+
+    /// @brief The minimum number of additional input elements required
+    ///
+    /// @details
+    /// Zero unless the result is `incomplete()`.
+    constexpr size_t needed() const noexcept {
+        return needed_;
+    }
+
     constexpr auto remaining() const {
         return rem_;
     }
@@ -157,17 +185,17 @@ class ParseResult {
 
     template <typename M>
     constexpr auto map(M&& mapper) & {
-        return map(value_, rem_, std::forward<M>(mapper));
+        return map(value_, rem_, needed_, std::forward<M>(mapper));
     }
 
     template <typename M>
     constexpr auto map(M&& mapper) const& {
-        return map(value_, rem_, std::forward<M>(mapper));
+        return map(value_, rem_, needed_, std::forward<M>(mapper));
     }
 
     template <typename M>
     constexpr auto map(M&& mapper) && {
-        return map(std::move(value_), rem_, std::forward<M>(mapper));
+        return map(std::move(value_), rem_, needed_, std::forward<M>(mapper));
     }
 };
 
@@ -189,6 +217,18 @@ constexpr auto fail(I&& remaining) {
     return ParseResultOf<T, I>(std::forward<I>(remaining), failure);
 }
 
+// Fails with the same reason as `cause`, which is either an ordinary
+// failure or an incomplete result.
+template <typename T, Input I, typename U, typename F, typename L>
+constexpr auto fail(I&& remaining, const ParseResult<U, F, L>& cause) {
+    return ParseResultOf<T, I>(std::forward<I>(remaining), incomplete_t{cause.needed()});
+}
+
+template <typename T, Input I>
+constexpr auto incomplete(I&& remaining, size_t needed) {
+    return ParseResultOf<T, I>(std::forward<I>(remaining), incomplete_t{needed});
+}
+
 }
 
 #endif
@@ -29,6 +29,11 @@ concept ParserOf1 = Input<I> && requires(P&& parser, I input) {
 template <typename I, typename P>
 concept ParseableBy1 = ParserOf1<P, I>;
 
+// Reports an invalid argument to a parser that is prepared at compile
+// time. Not constexpr, so that reaching it during constant evaluation is a
+// compile error that shows `message`.
+inline void compile_error([[maybe_unused]] const char* message) {}
+
 }
 
 template <typename P, typename... I>
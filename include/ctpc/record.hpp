@@ -0,0 +1,246 @@
+#ifndef CTPC_RECORD_HPP
+#define CTPC_RECORD_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "parser.hpp"
+#include "input.hpp"
+#include "parse_result.hpp"
+#include "integer.hpp"
+
+namespace ctpc {
+
+namespace detail {
+
+template <typename M>
+struct member_pointer_traits;
+
+template <typename C, typename M>
+struct member_pointer_traits<M C::*> {
+    using class_type = C;
+    using value_type = M;
+};
+
+template <typename T>
+concept RecordValue = (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) || std::is_enum_v<T>;
+
+template <size_t N>
+using record_uint_t = std::conditional_t<N == 1, uint8_t,
+                      std::conditional_t<N == 2, uint16_t,
+                      std::conditional_t<N == 4, uint32_t, uint64_t>>>;
+
+template <RecordValue T>
+constexpr T record_byteswap(T value) {
+    if constexpr (std::is_enum_v<T>) {
+        return static_cast<T>(utils::byteswap(static_cast<std::underlying_type_t<T>>(value)));
+    } else if constexpr (std::is_floating_point_v<T>) {
+        using U = record_uint_t<sizeof(T)>;
+        return std::bit_cast<T>(utils::byteswap(std::bit_cast<U>(value)));
+    } else {
+        return utils::byteswap(value);
+    }
+}
+
+}
+
+/// @brief Describes a field of a `record`
+///
+/// @details
+/// `MEMBER` is a pointer to a data member of the record type, and
+/// `ENDIANNESS` is the byte order of the field in the input. The member
+/// must be an arithmetic (other than `bool`) or enumeration type, and
+/// occupies `sizeof` the member type bytes of input.
+template <auto MEMBER, std::endian ENDIANNESS = std::endian::native>
+struct Field {
+    using class_type = typename detail::member_pointer_traits<decltype(MEMBER)>::class_type;
+    using value_type = typename detail::member_pointer_traits<decltype(MEMBER)>::value_type;
+
+    static_assert(detail::RecordValue<value_type>, "record fields must be arithmetic or enumeration types");
+
+    static constexpr auto member = MEMBER;
+    static constexpr std::endian endianness = ENDIANNESS;
+};
+
+template <auto MEMBER>
+using field_be = Field<MEMBER, std::endian::big>;
+
+template <auto MEMBER>
+using field_le = Field<MEMBER, std::endian::little>;
+
+template <typename T, typename... Fields>
+struct Record {
+  private:
+    static constexpr std::array<size_t, sizeof...(Fields)> sizes{sizeof(typename Fields::value_type)...};
+
+    static constexpr std::array<size_t, sizeof...(Fields)> offsets = [] {
+        std::array<size_t, sizeof...(Fields)> ret{};
+        size_t offset = 0;
+        for (size_t i = 0; i < ret.size(); ++i) {
+            ret[i] = offset;
+            offset += sizes[i];
+        }
+        return ret;
+    }();
+
+    template <size_t IDX>
+    using field_t = std::tuple_element_t<IDX, std::tuple<Fields...>>;
+
+    template <size_t IDX>
+    static constexpr void fill_pattern(T& record) {
+        using value_t = typename field_t<IDX>::value_type;
+        std::array<unsigned char, sizeof(value_t)> pattern{};
+        pattern.fill(static_cast<unsigned char>(IDX + 1));
+        record.*field_t<IDX>::member = std::bit_cast<value_t>(pattern);
+    }
+
+    template <size_t IDX>
+    static void read_field(T& record, const std::byte* data) {
+        using value_t = typename field_t<IDX>::value_type;
+        value_t value;
+        std::memcpy(&value, data + offsets[IDX], sizeof(value_t));
+        if constexpr (field_t<IDX>::endianness != std::endian::native) {
+            value = detail::record_byteswap(value);
+        }
+        record.*field_t<IDX>::member = value;
+    }
+
+    template <size_t IDX>
+    static constexpr void decode_field(T& record, const std::array<std::byte, (sizeof(typename Fields::value_type) + ... + 0)>& bytes) {
+        using value_t = typename field_t<IDX>::value_type;
+        std::array<std::byte, sizeof(value_t)> tmp{};
+        std::copy_n(bytes.begin() + offsets[IDX], sizeof(value_t), tmp.begin());
+        auto value = std::bit_cast<value_t>(tmp);
+        if constexpr (field_t<IDX>::endianness != std::endian::native) {
+            value = detail::record_byteswap(value);
+        }
+        record.*field_t<IDX>::member = value;
+    }
+
+  public:
+    /// @brief The number of input bytes consumed by the record
+    static constexpr size_t size = (sizeof(typename Fields::value_type) + ... + 0);
+
+    /// @brief Whether the input bytes are exactly the object
+    /// representation of `T`, so that the record is read with a single copy
+    ///
+    /// @details
+    /// This is checked by setting each field to a distinct byte pattern and
+    /// finding that pattern at the field's offset in the object
+    /// representation.
+    static constexpr bool native_layout = [] {
+        if constexpr (!((Fields::endianness == std::endian::native) && ...) ||
+                      sizeof(T) != (sizeof(typename Fields::value_type) + ... + 0) ||
+                      !std::is_trivially_copyable_v<T> ||
+                      !std::has_unique_object_representations_v<T> ||
+                      !std::is_default_constructible_v<T>) {
+            return false;
+        } else {
+            T probe{};
+            [&]<size_t... IDX>([[maybe_unused]] std::index_sequence<IDX...> idx) {
+                (fill_pattern<IDX>(probe), ...);
+            }(std::index_sequence_for<Fields...>{});
+            auto bytes = std::bit_cast<std::array<unsigned char, sizeof(T)>>(probe);
+            for (size_t i = 0; i < sizes.size(); ++i) {
+                for (size_t j = offsets[i]; j < offsets[i] + sizes[i]; ++j) {
+                    if (bytes[j] != static_cast<unsigned char>(i + 1)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+    }();
+
+    template <ByteInput I>
+    constexpr auto operator()(I input) const -> ParseResultOf<T, I> {
+        if constexpr (std::ranges::contiguous_range<I> && std::ranges::sized_range<I>) {
+            if (!std::is_constant_evaluated()) {
+                if (std::ranges::size(input) < size) {
+                    if constexpr (StreamingInput<I>) {
+                        return incomplete<T>(input, size - std::ranges::size(input));
+                    } else {
+                        return fail<T>(input);
+                    }
+                }
+                auto data = reinterpret_cast<const std::byte*>(std::ranges::data(input));
+                T record{};
+                if constexpr (native_layout) {
+                    std::memcpy(&record, data, size);
+                } else {
+                    [&]<size_t... IDX>([[maybe_unused]] std::index_sequence<IDX...> idx) {
+                        (read_field<IDX>(record, data), ...);
+                    }(std::index_sequence_for<Fields...>{});
+                }
+                return pass<T>(
+                    std::ranges::subrange(std::ranges::next(std::ranges::begin(input), size), std::ranges::end(input)),
+                    std::move(record)
+                );
+            }
+        }
+
+        std::array<std::byte, size> bytes{};
+        auto it = std::ranges::begin(input);
+        auto end = std::ranges::end(input);
+        for (size_t i = 0; i < size; ++i, ++it) {
+            if (it == end) {
+                if constexpr (StreamingInput<I>) {
+                    return incomplete<T>(input, size - i);
+                } else {
+                    return fail<T>(input);
+                }
+            }
+            bytes[i] = static_cast<std::byte>(*it);
+        }
+        T record{};
+        [&]<size_t... IDX>([[maybe_unused]] std::index_sequence<IDX...> idx) {
+            (decode_field<IDX>(record, bytes), ...);
+        }(std::index_sequence_for<Fields...>{});
+        return pass<T>(std::ranges::subrange(it, end), std::move(record));
+    }
+};
+
+/// @brief Parses a fixed layout binary record into a struct
+/// @ingroup ctpc_parsers
+///
+/// Parser signature:
+/// ```
+/// record<T, Field...> -> T
+/// ```
+///
+/// Reads each `Field` in order from consecutive input bytes, converting
+/// from the field's byte order, and stores it into the corresponding
+/// member of a value-initialized `T`. The length of the input is checked
+/// once for the whole record rather than once per byte. When every field
+/// is in native byte order and the fields exactly cover the object
+/// representation of `T` in declaration order, the record is read with a
+/// single copy.
+///
+/// ```
+/// struct Header {
+///     uint32_t magic;
+///     uint16_t version;
+///     uint16_t flags;
+/// };
+///
+/// static constexpr auto header = record<
+///     Header,
+///     field_be<&Header::magic>,
+///     field_le<&Header::version>,
+///     field_le<&Header::flags>
+/// >;
+/// ```
+template <typename T, typename... Fields>
+static constexpr Record<T, Fields...> record{};
+
+}
+
+#endif
@@ -2,16 +2,214 @@
 #define CTPC_REGEX_MATCH_HPP
 
 #include <ctre.hpp>
+#include <optional>
 #include <ranges>
 
 #include "parser.hpp"
 #include "input.hpp"
 #include "parse_result.hpp"
+#include "first_set.hpp"
+#include "error.hpp"
+#include "utf.hpp"
 
 namespace ctpc {
 
+namespace detail {
+
+constexpr bool regex_is_ascii_alnum(char32_t c) {
+    return (c >= U'0' && c <= U'9') || (c >= U'a' && c <= U'z') || (c >= U'A' && c <= U'Z');
+}
+
+// Set of characters matched by the escape sequence `\c`, or `std::nullopt`
+// for escapes that are not understood.
+constexpr std::optional<FirstSet> regex_escape_set(char32_t c) {
+    FirstSet set{};
+    switch (c) {
+        case U'd':
+        case U'D':
+            set.insert(U'0', U'9');
+            break;
+        case U's':
+        case U'S':
+            for (auto ws : {U' ', U'\t', U'\n', U'\v', U'\f', U'\r'}) {
+                set.insert(ws);
+            }
+            break;
+        case U'w':
+        case U'W':
+            set.insert(U'0', U'9');
+            set.insert(U'a', U'z');
+            set.insert(U'A', U'Z');
+            set.insert(U'_');
+            break;
+        case U'n':
+            set.insert(U'\n');
+            return set;
+        case U'r':
+            set.insert(U'\r');
+            return set;
+        case U't':
+            set.insert(U'\t');
+            return set;
+        case U'f':
+            set.insert(U'\f');
+            return set;
+        case U'v':
+            set.insert(U'\v');
+            return set;
+        default:
+            if (c < 0x80 && !regex_is_ascii_alnum(c)) {
+                set.insert(static_cast<uint32_t>(c));
+                return set;
+            }
+            return std::nullopt;
+    }
+    if (c == U'D' || c == U'S' || c == U'W') {
+        return set.complement();
+    }
+    return set;
+}
+
+// Parses a bracket expression starting after the opening `[`. On success,
+// `pos` is left one past the closing `]`.
+template <typename Regex>
+constexpr std::optional<FirstSet> regex_class_set(const Regex& regex, size_t& pos) {
+    FirstSet set{};
+    bool negate = false;
+    if (pos < regex.size() && regex[pos] == U'^') {
+        negate = true;
+        ++pos;
+    }
+    if (pos < regex.size() && regex[pos] == U']') {
+        return std::nullopt;
+    }
+
+    while (pos < regex.size() && regex[pos] != U']') {
+        auto c = regex[pos++];
+        if (c == U'\\') {
+            if (pos == regex.size()) {
+                return std::nullopt;
+            }
+            auto e = regex[pos++];
+            if (e == U'D' || e == U'S' || e == U'W') {
+                return std::nullopt;
+            }
+            auto escaped = regex_escape_set(e);
+            if (!escaped) {
+                return std::nullopt;
+            }
+            set |= *escaped;
+        } else if (c == U'[' || c >= 0x80) {
+            return std::nullopt;
+        } else if (pos + 1 < regex.size() && regex[pos] == U'-' && regex[pos + 1] != U']') {
+            auto last = regex[pos + 1];
+            if (last == U'\\' || last == U'[' || last >= 0x80 || last < c) {
+                return std::nullopt;
+            }
+            set.insert(static_cast<uint32_t>(c), static_cast<uint32_t>(last));
+            pos += 2;
+        } else {
+            set.insert(static_cast<uint32_t>(c));
+        }
+    }
+
+    if (pos == regex.size()) {
+        return std::nullopt;
+    }
+    ++pos;
+    return negate ? set.complement() : set;
+}
+
+// Computes the set of characters that `regex` can match as its first
+// character. This only understands patterns that start with a single
+// character, escape sequence, or bracket expression that must match at
+// least once. Any other pattern yields `std::nullopt`.
+template <typename Regex>
+constexpr std::optional<FirstSet> regex_first_set(const Regex& regex) {
+    bool in_class = false;
+    for (size_t i = 0; i < regex.size(); ++i) {
+        auto c = regex[i];
+        if (c == U'\\') {
+            ++i;
+        } else if (in_class) {
+            in_class = c != U']';
+        } else if (c == U'[') {
+            in_class = true;
+        } else if (c == U'|') {
+            return std::nullopt;
+        }
+    }
+
+    if (regex.size() == 0) {
+        return std::nullopt;
+    }
+
+    size_t pos = 0;
+    std::optional<FirstSet> set{};
+    auto c = regex[pos++];
+    if (c == U'\\') {
+        if (pos == regex.size()) {
+            return std::nullopt;
+        }
+        set = regex_escape_set(regex[pos++]);
+    } else if (c == U'[') {
+        set = regex_class_set(regex, pos);
+    } else if (c < 0x80 && !regex_is_ascii_alnum(c)) {
+        switch (c) {
+            case U'(':
+            case U')':
+            case U'^':
+            case U'$':
+            case U'.':
+            case U'*':
+            case U'+':
+            case U'?':
+            case U'{':
+            case U'}':
+            case U']':
+                return std::nullopt;
+            default:
+                set.emplace();
+                set->insert(static_cast<uint32_t>(c));
+        }
+    } else if (c < 0x80) {
+        set.emplace();
+        set->insert(static_cast<uint32_t>(c));
+    }
+
+    if (set && pos < regex.size()) {
+        auto q = regex[pos];
+        if (q == U'*' || q == U'?') {
+            return std::nullopt;
+        } else if (q == U'{' && (pos + 1 == regex.size() || regex[pos + 1] == U'0' || regex[pos + 1] == U',')) {
+            return std::nullopt;
+        }
+    }
+    return set;
+}
+
+// The name `regex_match<REGEX>` reports to an error context, which is the
+// pattern itself.
+template <ctll::fixed_string REGEX>
+inline constexpr std::string_view regex_error_name = error_name<[](ErrorNameWriter& writer) {
+    for (size_t i = 0; i < REGEX.size(); ++i) {
+        writer.put_utf8(static_cast<uint32_t>(REGEX[i]));
+    }
+}>;
+
+}
+
 template <ctll::fixed_string REGEX>
 struct RegexMatch {
+    template <typename Elem>
+    static constexpr std::optional<detail::FirstSet> first_set() {
+        if constexpr (utils::is_text_char_v<Elem>) {
+            return detail::regex_first_set(REGEX);
+        } else {
+            return std::nullopt;
+        }
+    }
+
     constexpr auto operator()(TextInput auto input) const {
         auto begin = std::ranges::begin(input);
         auto end = std::ranges::end(input);
@@ -20,6 +218,7 @@ struct RegexMatch {
         if (res) {
             return pass<ret_t>(std::ranges::subrange(res.end(), end), std::ranges::subrange(res.begin(), res.end()));
         } else {
+            detail::report_expected(input, detail::regex_error_name<REGEX>);
             return fail<ret_t>(input);
         }
     }
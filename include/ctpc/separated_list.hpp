@@ -0,0 +1,204 @@
+#ifndef CTPC_SEPARATED_LIST_HPP
+#define CTPC_SEPARATED_LIST_HPP
+
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "parser.hpp"
+#include "input.hpp"
+#include "parse_result.hpp"
+#include "utils.hpp"
+#include "first_set.hpp"
+
+namespace ctpc {
+
+namespace detail {
+
+template <bool NONEMPTY, typename P, typename S, typename R, typename T, typename H>
+struct SeparatedListParser {
+  private:
+    CTPC_NO_UNIQUE_ADDR P parser_;
+    CTPC_NO_UNIQUE_ADDR S sep_;
+    CTPC_NO_UNIQUE_ADDR R reduce_;
+    CTPC_NO_UNIQUE_ADDR T init_;
+    CTPC_NO_UNIQUE_ADDR H hint_;
+
+    static constexpr bool has_hint = !std::is_same_v<std::remove_cvref_t<H>, utils::NoSizeHint>;
+
+    template <ParseableBy<P> I>
+    constexpr auto init([[maybe_unused]] const I& input) const {
+        if constexpr (std::is_same_v<std::remove_cvref_t<T>, utils::DefaultReduceInit>) {
+            using item_t = decltype(*parser_(std::declval<I>()));
+            using accum_t = decltype(utils::invoke_unpacked(reduce_, utils::default_init, std::declval<item_t>()));
+            accum_t accum{};
+            if constexpr (has_hint && utils::Reservable<accum_t>) {
+                accum.reserve(utils::size_hint(hint_, input));
+            }
+            return accum;
+        } else if constexpr (has_hint && std::invocable<T, size_t>) {
+            return init_(utils::size_hint(hint_, input));
+        } else if constexpr (std::invocable<T>) {
+            return init_();
+        } else {
+            return init_;
+        }
+    }
+
+  public:
+    constexpr SeparatedListParser(P&& parser, S&& sep, R&& reduce, T&& init, H&& hint)
+        : parser_(std::forward<P>(parser)),
+          sep_(std::forward<S>(sep)),
+          reduce_(std::forward<R>(reduce)),
+          init_(std::forward<T>(init)),
+          hint_(std::forward<H>(hint)) {}
+
+    template <typename Elem>
+    static constexpr std::optional<FirstSet> first_set() {
+        if constexpr (NONEMPTY) {
+            return first_set_of<P, Elem>();
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    template <ParseableBy<P, S> I>
+    constexpr auto operator()(I input) const {
+        using accum_t = decltype(init(input));
+        std::ranges::subrange in{input};
+
+        auto first = parser_(in);
+        if (!first) {
+            if constexpr (NONEMPTY) {
+                return fail<accum_t>(input, first);
+            } else {
+                if constexpr (StreamingInput<I>) {
+                    if (first.incomplete()) {
+                        return incomplete<accum_t>(input, first.needed());
+                    }
+                }
+                return pass<accum_t>(in, init(input));
+            }
+        }
+        in = first.remaining();
+        auto accum = init(input);
+        utils::reduce_into(reduce_, accum, *std::move(first));
+
+        for (;;) {
+            auto sep = sep_(in);
+            if (!sep) {
+                if constexpr (StreamingInput<I>) {
+                    if (sep.incomplete()) {
+                        return incomplete<accum_t>(input, sep.needed());
+                    }
+                }
+                break;
+            }
+            auto res = parser_(sep.remaining());
+            if (!res) {
+                if constexpr (StreamingInput<I>) {
+                    if (res.incomplete()) {
+                        return incomplete<accum_t>(input, res.needed());
+                    }
+                }
+                break;
+            }
+            auto rem = res.remaining();
+            if (std::ranges::begin(rem) == std::ranges::begin(in)) {
+                // Neither the separator nor the item consumed anything
+                break;
+            }
+            in = rem;
+            utils::reduce_into(reduce_, accum, *std::move(res));
+        }
+
+        return pass<accum_t>(in, std::move(accum));
+    }
+};
+
+}
+
+struct SeparatedList0 {
+    template <typename P,
+              typename S,
+              typename R = const utils::DefaultReduce&,
+              typename T = const utils::DefaultReduceInit&,
+              typename H = utils::NoSizeHint>
+    constexpr auto operator()(P&& parser,
+                              S&& sep,
+                              R&& reduce = utils::default_reduce,
+                              T&& init = utils::default_reduce_init,
+                              H&& hint = {}) const -> detail::SeparatedListParser<false, P, S, R, T, H> {
+        return detail::SeparatedListParser<false, P, S, R, T, H>(
+            std::forward<P>(parser),
+            std::forward<S>(sep),
+            std::forward<R>(reduce),
+            std::forward<T>(init),
+            std::forward<H>(hint)
+        );
+    }
+};
+
+/// @brief Parses zero or more items separated by a separator
+/// @ingroup ctpc_combinators
+///
+/// Combinator signature:
+/// ```
+/// separated_list0(Parser parser, Parser sep, Reduce reduce = default_reduce,
+///                 Init init = default_reduce_init, SizeHint hint = {}) -> T
+/// ```
+///
+/// Parses `parser`, then `sep` followed by `parser` for as long as both
+/// succeed, and folds each item into a single accumulator with `reduce`
+/// and `init`, like `many0`. The values of `sep` are discarded. A
+/// separator that is not followed by an item is not consumed, so a
+/// trailing separator is left in the remaining input. Passes with the
+/// initial accumulator if the first item fails to parse. As with
+/// `many0_sized`, an optional `hint` estimates the number of items so the
+/// accumulator can be reserved up front.
+///
+/// ```
+/// static constexpr auto args = separated_list0(expr, verbatim<",">);
+/// static constexpr auto fields = separated_list0(field, verbatim<";">,
+///     utils::default_reduce, utils::default_reduce_init,
+///     [](auto input) { return utils::count_of(';')(input) + 1; });
+/// ```
+static constexpr SeparatedList0 separated_list0{};
+
+struct SeparatedList1 {
+    template <typename P,
+              typename S,
+              typename R = const utils::DefaultReduce&,
+              typename T = const utils::DefaultReduceInit&,
+              typename H = utils::NoSizeHint>
+    constexpr auto operator()(P&& parser,
+                              S&& sep,
+                              R&& reduce = utils::default_reduce,
+                              T&& init = utils::default_reduce_init,
+                              H&& hint = {}) const -> detail::SeparatedListParser<true, P, S, R, T, H> {
+        return detail::SeparatedListParser<true, P, S, R, T, H>(
+            std::forward<P>(parser),
+            std::forward<S>(sep),
+            std::forward<R>(reduce),
+            std::forward<T>(init),
+            std::forward<H>(hint)
+        );
+    }
+};
+
+/// @brief Parses one or more items separated by a separator
+/// @ingroup ctpc_combinators
+///
+/// Combinator signature:
+/// ```
+/// separated_list1(Parser parser, Parser sep, Reduce reduce = default_reduce,
+///                 Init init = default_reduce_init, SizeHint hint = {}) -> T
+/// ```
+///
+/// Like `separated_list0`, but fails if the first item fails to parse.
+static constexpr SeparatedList1 separated_list1{};
+
+}
+
+#endif
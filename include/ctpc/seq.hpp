@@ -5,6 +5,7 @@
 #include "input.hpp"
 #include "parse_result.hpp"
 #include "utils.hpp"
+#include "first_set.hpp"
 
 namespace ctpc {
 
@@ -55,7 +56,7 @@ struct SeqParser<P1, PN...> {
                 return inner_.call(res.remaining(), std::forward<Ret>(ret)...);
             } else {
                 using res_t = std::remove_cvref_t<decltype(inner_.call(res.remaining(), std::forward<Ret>(ret)...))>;
-                return fail<typename res_t::value_type>(input);
+                return fail<typename res_t::value_type>(input, res);
             }
         } else {
             if (res) {
@@ -63,7 +64,7 @@ struct SeqParser<P1, PN...> {
                 return inner_.call(rem, std::forward<Ret>(ret)..., *std::move(res));
             } else {
                 using res_t = std::remove_cvref_t<decltype(inner_.call(res.remaining(), std::forward<Ret>(ret)..., *std::move(res)))>;
-                return fail<typename res_t::value_type>(input);
+                return fail<typename res_t::value_type>(input, res);
             }
         }
     }
@@ -73,12 +74,17 @@ struct SeqParser<P1, PN...> {
         : parser_(std::forward<P1>(parser)),
           inner_(std::forward<PN>(inner)...) {}
 
+    template <typename Elem>
+    static constexpr std::optional<FirstSet> first_set() {
+        return first_set_of<P1, Elem>();
+    }
+
     constexpr auto operator()(ParseableBy<P1> auto input) const {
         auto res = call(input);
         if (res) {
             return res;
         } else {
-            return fail<typename std::remove_cvref_t<decltype(res)>::value_type>(input);
+            return fail<typename std::remove_cvref_t<decltype(res)>::value_type>(input, res);
         }
     }
 };
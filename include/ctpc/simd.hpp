@@ -0,0 +1,172 @@
+#ifndef CTPC_SIMD_HPP
+#define CTPC_SIMD_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CTPC_SIMD_AVX2 1
+#define CTPC_SIMD_SSE2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CTPC_SIMD_SSE2 1
+#endif
+
+// Runtime helpers for operating on contiguous memory. None of these are
+// usable during constant evaluation; callers must check
+// `std::is_constant_evaluated()` and fall back to element-wise code.
+namespace ctpc::detail::simd {
+
+template <typename T>
+inline T load(const void* ptr) {
+    T ret;
+    std::memcpy(&ret, ptr, sizeof(T));
+    return ret;
+}
+
+// Compares `size` bytes at `lhs` and `rhs` for equality.
+inline bool equal(const void* lhs, const void* rhs, size_t size) {
+    auto l = static_cast<const unsigned char*>(lhs);
+    auto r = static_cast<const unsigned char*>(rhs);
+
+    if (size >= 16) {
+#if defined(CTPC_SIMD_AVX2)
+        while (size >= 32) {
+            auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(l));
+            auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r));
+            if (static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b))) != 0xFFFF'FFFFu) {
+                return false;
+            }
+            l += 32;
+            r += 32;
+            size -= 32;
+        }
+#endif
+#if defined(CTPC_SIMD_SSE2)
+        while (size >= 16) {
+            auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(l));
+            auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xFFFF) {
+                return false;
+            }
+            l += 16;
+            r += 16;
+            size -= 16;
+        }
+#else
+        while (size >= 16) {
+            if (((load<uint64_t>(l) ^ load<uint64_t>(r)) | (load<uint64_t>(l + 8) ^ load<uint64_t>(r + 8))) != 0) {
+                return false;
+            }
+            l += 16;
+            r += 16;
+            size -= 16;
+        }
+#endif
+    }
+
+    // The remaining bytes are compared with two overlapping loads.
+    if (size >= 8) {
+        return ((load<uint64_t>(l) ^ load<uint64_t>(r)) |
+                (load<uint64_t>(l + size - 8) ^ load<uint64_t>(r + size - 8))) == 0;
+    } else if (size >= 4) {
+        return ((load<uint32_t>(l) ^ load<uint32_t>(r)) |
+                (load<uint32_t>(l + size - 4) ^ load<uint32_t>(r + size - 4))) == 0;
+    } else if (size >= 2) {
+        return ((load<uint16_t>(l) ^ load<uint16_t>(r)) |
+                (load<uint16_t>(l + size - 2) ^ load<uint16_t>(r + size - 2))) == 0;
+    } else if (size == 1) {
+        return *l == *r;
+    }
+    return true;
+}
+
+// Finds the first of `size` bytes at `data` that is equal to any of the
+// bytes in `set`. Returns `size` if there is none.
+template <size_t N>
+inline size_t find_any(const void* data, size_t size, const unsigned char (&set)[N]) {
+    static_assert(N > 0);
+    auto p = static_cast<const unsigned char*>(data);
+    if constexpr (N == 1) {
+        auto found = static_cast<const unsigned char*>(std::memchr(p, set[0], size));
+        return found == nullptr ? size : static_cast<size_t>(found - p);
+    } else {
+        size_t i = 0;
+#if defined(CTPC_SIMD_AVX2)
+        __m256i wide[N];
+        for (size_t j = 0; j < N; ++j) {
+            wide[j] = _mm256_set1_epi8(static_cast<char>(set[j]));
+        }
+        for (; i + 32 <= size; i += 32) {
+            auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+            auto hits = _mm256_cmpeq_epi8(chunk, wide[0]);
+            for (size_t j = 1; j < N; ++j) {
+                hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(chunk, wide[j]));
+            }
+            auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+            if (mask != 0) {
+                return i + static_cast<size_t>(std::countr_zero(mask));
+            }
+        }
+#endif
+#if defined(CTPC_SIMD_SSE2)
+        __m128i narrow[N];
+        for (size_t j = 0; j < N; ++j) {
+            narrow[j] = _mm_set1_epi8(static_cast<char>(set[j]));
+        }
+        for (; i + 16 <= size; i += 16) {
+            auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+            auto hits = _mm_cmpeq_epi8(chunk, narrow[0]);
+            for (size_t j = 1; j < N; ++j) {
+                hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, narrow[j]));
+            }
+            auto mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+            if (mask != 0) {
+                return i + static_cast<size_t>(std::countr_zero(mask));
+            }
+        }
+#endif
+        for (; i < size; ++i) {
+            for (size_t j = 0; j < N; ++j) {
+                if (p[i] == set[j]) {
+                    return i;
+                }
+            }
+        }
+        return size;
+    }
+}
+
+// Finds the first of `size` bytes at `data` for which the 256 entry
+// `table` is false. Returns `size` if there is none.
+inline size_t find_not_in(const void* data, size_t size, const bool* table) {
+    auto p = static_cast<const unsigned char*>(data);
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        if (!table[p[i]]) {
+            return i;
+        }
+        if (!table[p[i + 1]]) {
+            return i + 1;
+        }
+        if (!table[p[i + 2]]) {
+            return i + 2;
+        }
+        if (!table[p[i + 3]]) {
+            return i + 3;
+        }
+    }
+    for (; i < size; ++i) {
+        if (!table[p[i]]) {
+            return i;
+        }
+    }
+    return size;
+}
+
+}
+
+#endif
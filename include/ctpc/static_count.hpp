@@ -6,6 +6,7 @@
 #include "parser.hpp"
 #include "input.hpp"
 #include "parse_result.hpp"
+#include "utils.hpp"
 
 namespace ctpc {
 
@@ -29,12 +30,12 @@ struct StaticCountParser {
         for (size_t i = 0; i < N; ++i) {
             auto res = parser_(in);
             if (!res) {
-                return fail<std::array<item_t, N>>(input);
+                return fail<std::array<item_t, N>>(input, res);
             }
             in = res.remaining();
             ret[i] = *std::move(res);
         }
-        return pass<std::array<item_t, N>>(input, std::move(ret));
+        return pass<std::array<item_t, N>>(in, std::move(ret));
     }
 };
 
@@ -42,7 +43,7 @@ struct StaticCountParser {
 
 template <size_t N>
 struct StaticCount {
-    template <typename P, typename R, typename T>
+    template <typename P>
     constexpr auto operator()(P&& parser) const -> detail::StaticCountParser<N, P> {
         return detail::StaticCountParser<N, P>(std::forward<P>(parser));
     }
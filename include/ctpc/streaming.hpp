@@ -0,0 +1,140 @@
+#ifndef CTPC_STREAMING_HPP
+#define CTPC_STREAMING_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "parser.hpp"
+#include "input.hpp"
+#include "parse_result.hpp"
+#include "utils.hpp"
+
+namespace ctpc {
+
+/// @brief Incrementally parses a sequence of messages from chunked input
+///
+/// @details
+/// See `streaming`.
+template <typename Elem, typename P>
+class StreamParser {
+  public:
+    using input_type = std::ranges::subrange<const Elem*, StreamEnd<const Elem*>>;
+    using result_type = std::remove_cvref_t<decltype(std::declval<const P&>()(std::declval<input_type>()))>;
+
+  private:
+    CTPC_NO_UNIQUE_ADDR P parser_;
+    std::vector<Elem> buffer_{};
+    size_t head_{0};
+    size_t tail_{0};
+    // Buffered size required before the parser is worth running again.
+    size_t wanted_{0};
+
+    constexpr input_type buffered_input() const {
+        return input_type(buffer_.data() + head_, StreamEnd<const Elem*>{buffer_.data() + tail_});
+    }
+
+  public:
+    explicit constexpr StreamParser(P&& parser)
+        : parser_(std::forward<P>(parser)) {}
+
+    /// @brief Appends a chunk of input
+    ///
+    /// @details
+    /// Consumed input is discarded when the buffer would otherwise need to
+    /// grow, so the buffer only ever holds about one partial message plus
+    /// the most recent chunk. Any result previously returned by `next`
+    /// that refers to the input is invalidated.
+    constexpr void feed(std::span<const Elem> chunk) {
+        if (tail_ + chunk.size() > buffer_.size()) {
+            if (head_ != 0) {
+                std::copy(buffer_.begin() + head_, buffer_.begin() + tail_, buffer_.begin());
+                tail_ -= head_;
+                head_ = 0;
+            }
+            if (tail_ + chunk.size() > buffer_.size()) {
+                buffer_.resize(std::max(buffer_.size() * 2, tail_ + chunk.size()));
+            }
+        }
+        std::ranges::copy(chunk, buffer_.begin() + tail_);
+        tail_ += chunk.size();
+    }
+
+    /// @brief Parses the next message from the buffered input
+    ///
+    /// @details
+    /// On success, the message's input is consumed. If the result is
+    /// incomplete, nothing is consumed, and the parser will not be run
+    /// again until at least `needed()` more elements have been fed, so
+    /// calling `next` after every `feed` does not re-parse a partial
+    /// message once per chunk. On failure, nothing is consumed.
+    constexpr result_type next() {
+        auto input = buffered_input();
+        if (buffered() < wanted_) {
+            return incomplete<typename result_type::value_type>(input, wanted_ - buffered());
+        }
+        auto res = parser_(input);
+        if (res) {
+            head_ = static_cast<size_t>(std::ranges::begin(res.remaining()) - buffer_.data());
+            wanted_ = 0;
+        } else if (res.incomplete()) {
+            wanted_ = buffered() + res.needed();
+        }
+        return res;
+    }
+
+    /// @brief The number of elements fed but not yet consumed
+    constexpr size_t buffered() const noexcept {
+        return tail_ - head_;
+    }
+
+    /// @brief Discards all buffered input
+    constexpr void reset() noexcept {
+        head_ = 0;
+        tail_ = 0;
+        wanted_ = 0;
+    }
+};
+
+template <typename Elem>
+struct Streaming {
+    template <typename P>
+    constexpr auto operator()(P&& parser) const -> StreamParser<Elem, P> {
+        return StreamParser<Elem, P>(std::forward<P>(parser));
+    }
+};
+
+/// @brief Creates a driver that parses messages from chunked input
+///
+/// Signature:
+/// ```
+/// streaming<Elem>(Parser parser) -> StreamParser<Elem, Parser>
+/// ```
+///
+/// The returned `StreamParser` buffers chunks of `Elem` passed to `feed`,
+/// and `next` runs `parser` on the buffered input as a streaming input
+/// (see `StreamEnd`). When a message is cut off by the end of the buffered
+/// input, `next` returns an incomplete result stating how many more
+/// elements are needed at minimum, and parsing starts over from the
+/// beginning of the message once they have arrived. Results are only
+/// valid until the next call to `feed`.
+///
+/// ```
+/// auto stream = streaming<std::byte>(message);
+/// while (auto chunk = read_some(socket)) {
+///     stream.feed(*chunk);
+///     while (auto res = stream.next()) {
+///         handle(*res);
+///     }
+/// }
+/// ```
+template <typename Elem>
+static constexpr Streaming<Elem> streaming{};
+
+}
+
+#endif
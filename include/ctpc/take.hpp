@@ -0,0 +1,316 @@
+#ifndef CTPC_TAKE_HPP
+#define CTPC_TAKE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+#include <type_traits>
+#include <ctll/fixed_string.hpp>
+
+#include "parser.hpp"
+#include "input.hpp"
+#include "parse_result.hpp"
+#include "first_set.hpp"
+#include "simd.hpp"
+
+namespace ctpc {
+
+namespace detail {
+
+template <typename I>
+using take_elem_t = std::remove_cvref_t<std::ranges::range_value_t<I>>;
+
+template <typename I>
+concept TakeInput = Input<I> && CodeUnit<take_elem_t<I>>;
+
+// Inputs that are scanned with `memchr` or SIMD instead of element-wise.
+template <typename I>
+concept TakeFastInput = TakeInput<I> &&
+                        std::ranges::contiguous_range<I> &&
+                        std::ranges::sized_range<I> &&
+                        sizeof(take_elem_t<I>) == 1;
+
+template <typename I>
+using take_result_t = std::ranges::subrange<std::ranges::iterator_t<I>>;
+
+// Splits `input` at the `n`th element into the result and the remaining
+// input.
+template <typename I>
+constexpr auto take_split(I& input, size_t n) {
+    auto begin = std::ranges::begin(input);
+    auto it = std::ranges::next(begin, static_cast<std::ranges::range_difference_t<I>>(n));
+    return pass<take_result_t<I>>(std::ranges::subrange(it, std::ranges::end(input)), take_result_t<I>(begin, it));
+}
+
+template <typename Elem>
+constexpr Elem take_from_unit(uint32_t unit) {
+    if constexpr (std::is_same_v<Elem, std::byte>) {
+        return static_cast<std::byte>(unit);
+    } else {
+        return static_cast<Elem>(static_cast<std::make_unsigned_t<Elem>>(unit));
+    }
+}
+
+}
+
+template <auto PRED>
+struct TakeWhile {
+  private:
+    // Whether the predicate holds for each code unit below 256
+    template <typename Elem>
+    static constexpr std::array<bool, 256> table = [] {
+        std::array<bool, 256> ret{};
+        for (uint32_t unit = 0; unit < 256; ++unit) {
+            ret[unit] = static_cast<bool>(PRED(detail::take_from_unit<Elem>(unit)));
+        }
+        return ret;
+    }();
+
+    template <typename Elem>
+    static constexpr bool matches(Elem elem) {
+        auto unit = detail::code_unit(elem);
+        if (unit < 256) {
+            return table<Elem>[unit];
+        }
+        return static_cast<bool>(PRED(elem));
+    }
+
+  public:
+    template <detail::TakeInput I>
+    constexpr auto operator()(I input) const {
+        using elem_t = detail::take_elem_t<I>;
+        using ret_t = detail::take_result_t<I>;
+        if constexpr (detail::TakeFastInput<I>) {
+            if (!std::is_constant_evaluated()) {
+                auto size = static_cast<size_t>(std::ranges::size(input));
+                auto n = detail::simd::find_not_in(std::ranges::data(input), size, table<elem_t>.data());
+                if constexpr (StreamingInput<I>) {
+                    if (n == size) {
+                        return incomplete<ret_t>(input, 1);
+                    }
+                }
+                return detail::take_split(input, n);
+            }
+        }
+        auto begin = std::ranges::begin(input);
+        auto end = std::ranges::end(input);
+        auto it = begin;
+        while (it != end && matches(static_cast<elem_t>(*it))) {
+            ++it;
+        }
+        if constexpr (StreamingInput<I>) {
+            if (it == end) {
+                return incomplete<ret_t>(input, 1);
+            }
+        }
+        return pass<ret_t>(std::ranges::subrange(it, end), ret_t(begin, it));
+    }
+};
+
+/// @brief Consumes elements while a predicate holds
+/// @ingroup ctpc_parsers
+///
+/// Parser signature:
+/// ```
+/// take_while<Predicate> -> subrange
+/// ```
+///
+/// Returns the longest prefix of the input whose elements all satisfy
+/// `PRED`, which may be empty, without copying it. `PRED` must be a
+/// `constexpr` callable taking a code unit of the input, such as a
+/// captureless lambda. Its result for every value below 256 is tabulated
+/// at compile time, so text and byte inputs are scanned with one table
+/// lookup per element. On a streaming input, reaching the end of the
+/// input is incomplete, since more input may continue the run.
+///
+/// ```
+/// static constexpr auto digits = take_while<[](char c) { return c >= '0' && c <= '9'; }>;
+/// ```
+template <auto PRED>
+static constexpr TakeWhile<PRED> take_while{};
+
+template <auto... DELIMS>
+struct TakeTill {
+  private:
+    static_assert(sizeof...(DELIMS) > 0, "take_till requires at least one delimiter");
+    static_assert((detail::CodeUnit<decltype(DELIMS)> && ...), "take_till delimiters must be characters or bytes");
+
+    static constexpr bool narrow = ((detail::code_unit(DELIMS) < 256) && ...);
+
+    // Delimiters as bytes, for inputs of single byte elements
+    static constexpr unsigned char bytes[] = {static_cast<unsigned char>(detail::code_unit(DELIMS))...};
+
+    // Whether each code unit below 256 is not a delimiter
+    static constexpr std::array<bool, 256> keep = [] {
+        std::array<bool, 256> ret{};
+        ret.fill(true);
+        ((detail::code_unit(DELIMS) < 256 ? ret[detail::code_unit(DELIMS)] = false : false), ...);
+        return ret;
+    }();
+
+    template <typename Elem>
+    static constexpr bool is_delim(Elem elem) {
+        auto unit = detail::code_unit(elem);
+        return ((unit == detail::code_unit(DELIMS)) || ...);
+    }
+
+  public:
+    template <detail::TakeInput I>
+    constexpr auto operator()(I input) const {
+        using elem_t = detail::take_elem_t<I>;
+        using ret_t = detail::take_result_t<I>;
+        if constexpr (detail::TakeFastInput<I> && narrow) {
+            if (!std::is_constant_evaluated()) {
+                auto size = static_cast<size_t>(std::ranges::size(input));
+                size_t n = 0;
+                if constexpr (sizeof...(DELIMS) <= 4) {
+                    n = detail::simd::find_any(std::ranges::data(input), size, bytes);
+                } else {
+                    n = detail::simd::find_not_in(std::ranges::data(input), size, keep.data());
+                }
+                if constexpr (StreamingInput<I>) {
+                    if (n == size) {
+                        return incomplete<ret_t>(input, 1);
+                    }
+                }
+                return detail::take_split(input, n);
+            }
+        }
+        auto begin = std::ranges::begin(input);
+        auto end = std::ranges::end(input);
+        auto it = begin;
+        while (it != end && !is_delim(static_cast<elem_t>(*it))) {
+            ++it;
+        }
+        if constexpr (StreamingInput<I>) {
+            if (it == end) {
+                return incomplete<ret_t>(input, 1);
+            }
+        }
+        return pass<ret_t>(std::ranges::subrange(it, end), ret_t(begin, it));
+    }
+};
+
+/// @brief Consumes elements up to the first of a set of delimiters
+/// @ingroup ctpc_parsers
+///
+/// Parser signature:
+/// ```
+/// take_till<Delim...> -> subrange
+/// ```
+///
+/// Returns the prefix of the input before the first element equal to any
+/// of `DELIMS`, or the whole input if there is none, without copying it.
+/// The delimiter is not consumed. Contiguous inputs of single byte
+/// elements are scanned with `memchr` for one delimiter, and with SIMD
+/// comparisons for up to four. On a streaming input, not finding a
+/// delimiter is incomplete.
+///
+/// ```
+/// static constexpr auto field = take_till<',', '\n'>;
+/// ```
+template <auto... DELIMS>
+static constexpr TakeTill<DELIMS...> take_till{};
+
+template <ctll::fixed_string LITERAL>
+struct TakeUntil {
+  private:
+    static constexpr size_t length = LITERAL.size();
+
+    // The literal as code units of `Elem`. Only UTF-32 inputs may use
+    // non-ASCII literals, as other encodings would need more than one
+    // code unit per character.
+    template <typename Elem>
+    static constexpr std::array<Elem, length> units = [] {
+        std::array<Elem, length> ret{};
+        for (size_t i = 0; i < length; ++i) {
+            auto c = static_cast<uint32_t>(LITERAL[i]);
+            if (c >= 0x80 && sizeof(Elem) < 4) {
+                detail::compile_error("ctpc::take_until: non-ASCII literals require UTF-32 input");
+            }
+            ret[i] = detail::take_from_unit<Elem>(c);
+        }
+        return ret;
+    }();
+
+  public:
+    template <detail::TakeInput I>
+    constexpr auto operator()(I input) const {
+        using elem_t = detail::take_elem_t<I>;
+        using ret_t = detail::take_result_t<I>;
+        if constexpr (length == 0) {
+            return detail::take_split(input, 0);
+        } else {
+            const auto& lit = units<elem_t>;
+            if constexpr (detail::TakeFastInput<I>) {
+                if (!std::is_constant_evaluated()) {
+                    auto data = reinterpret_cast<const unsigned char*>(std::ranges::data(input));
+                    auto size = static_cast<size_t>(std::ranges::size(input));
+                    auto first = static_cast<unsigned char>(detail::code_unit(lit[0]));
+                    size_t pos = 0;
+                    while (size - pos >= length) {
+                        auto found = static_cast<const unsigned char*>(std::memchr(data + pos, first, size - pos - length + 1));
+                        if (found == nullptr) {
+                            break;
+                        }
+                        auto idx = static_cast<size_t>(found - data);
+                        if (detail::simd::equal(found + 1, lit.data() + 1, length - 1)) {
+                            return detail::take_split(input, idx);
+                        }
+                        pos = idx + 1;
+                    }
+                    if constexpr (StreamingInput<I>) {
+                        return incomplete<ret_t>(input, 1);
+                    } else {
+                        return fail<ret_t>(input);
+                    }
+                }
+            }
+            auto begin = std::ranges::begin(input);
+            auto end = std::ranges::end(input);
+            for (auto it = begin; it != end; ++it) {
+                auto cur = it;
+                size_t i = 0;
+                while (i < length && cur != end && static_cast<elem_t>(*cur) == lit[i]) {
+                    ++cur;
+                    ++i;
+                }
+                if (i == length) {
+                    return pass<ret_t>(std::ranges::subrange(it, end), ret_t(begin, it));
+                }
+            }
+            if constexpr (StreamingInput<I>) {
+                return incomplete<ret_t>(input, 1);
+            } else {
+                return fail<ret_t>(input);
+            }
+        }
+    }
+};
+
+/// @brief Consumes elements up to the first occurrence of a literal
+/// @ingroup ctpc_parsers
+///
+/// Parser signature:
+/// ```
+/// take_until<Literal> -> subrange
+/// ```
+///
+/// Returns the prefix of the input before the first occurrence of
+/// `LITERAL`, without copying it, and fails if the literal does not occur
+/// in the input. The literal is not consumed. Contiguous inputs of single
+/// byte elements are searched with `memchr` for the first character of
+/// the literal, then compared in bulk. On a streaming input, not finding
+/// the literal is incomplete.
+///
+/// ```
+/// static constexpr auto header_value = take_until<"\r\n">;
+/// ```
+template <ctll::fixed_string LITERAL>
+static constexpr TakeUntil<LITERAL> take_until{};
+
+}
+
+#endif
@@ -0,0 +1,175 @@
+#ifndef CTPC_TOKEN_HPP
+#define CTPC_TOKEN_HPP
+
+#include <functional>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "parser.hpp"
+#include "input.hpp"
+#include "parse_result.hpp"
+#include "first_set.hpp"
+#include "utils.hpp"
+
+namespace ctpc {
+
+struct MakeTokenInput {
+    template <std::ranges::contiguous_range R>
+        requires TokenElement<std::remove_cvref_t<std::ranges::range_value_t<R>>>
+    constexpr auto operator()(const R& tokens) const {
+        using token_t = std::remove_cvref_t<std::ranges::range_value_t<R>>;
+        return std::span<const token_t>(std::ranges::data(tokens), std::ranges::size(tokens));
+    }
+};
+
+/// @brief Views a sequence of tokens as parser input
+///
+/// Signature:
+/// ```
+/// token_input(ContiguousRange tokens) -> std::span<const Token>
+/// ```
+///
+/// Returns a borrowed view of an already lexed sequence of tokens, such as
+/// a `std::vector<Token>`, so that a grammar written with `token` and
+/// `token_if` can backtrack over whole tokens instead of re-scanning the
+/// characters they were lexed from. The view is only valid for the
+/// lifetime of `tokens`. See `TokenElement` for the requirements on the
+/// token type.
+///
+/// ```
+/// std::vector<Token> tokens = lex(source);
+/// auto res = statement(token_input(tokens));
+/// ```
+static constexpr MakeTokenInput token_input{};
+
+namespace detail {
+
+template <typename I>
+using token_t = std::remove_cvref_t<std::ranges::range_value_t<I>>;
+
+template <typename I, auto KIND>
+concept TokenInputOfKind = TokenInput<I> && requires(const token_t<I>& token) {
+    { token_kind(token) == KIND } -> std::convertible_to<bool>;
+};
+
+template <typename F>
+struct TokenIfParser {
+  private:
+    CTPC_NO_UNIQUE_ADDR F pred_;
+
+  public:
+    explicit constexpr TokenIfParser(F&& pred)
+        : pred_(std::forward<F>(pred)) {}
+
+    template <TokenInput I>
+        requires std::predicate<const F&, const token_t<I>&>
+    constexpr auto operator()(I input) const {
+        auto i = std::ranges::begin(input);
+        auto e = std::ranges::end(input);
+        if (i == e) {
+            if constexpr (StreamingInput<I>) {
+                return incomplete<token_t<I>>(input, 1);
+            } else {
+                return fail<token_t<I>>(input);
+            }
+        }
+        token_t<I> token = *i;
+        if (!std::invoke(pred_, std::as_const(token))) {
+            return fail<token_t<I>>(input);
+        }
+        ++i;
+        return pass<token_t<I>>(std::ranges::subrange(i, e), std::move(token));
+    }
+};
+
+}
+
+template <auto KIND>
+struct MatchToken {
+    template <typename Elem>
+    static constexpr std::optional<detail::FirstSet> first_set() {
+        if constexpr (detail::KeyedElement<Elem> && !detail::CodeUnit<Elem> &&
+                      std::is_same_v<decltype(token_kind(std::declval<const Elem&>())), decltype(KIND)>) {
+            detail::FirstSet set{};
+            set.insert(detail::kind_key(KIND));
+            return set;
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    template <detail::TokenInputOfKind<KIND> I>
+    constexpr auto operator()(I input) const {
+        using token_t = detail::token_t<I>;
+        auto i = std::ranges::begin(input);
+        auto e = std::ranges::end(input);
+        if (i == e) {
+            if constexpr (StreamingInput<I>) {
+                return incomplete<token_t>(input, 1);
+            } else {
+                return fail<token_t>(input);
+            }
+        }
+        const token_t& token = *i;
+        if (!(token_kind(token) == KIND)) {
+            return fail<token_t>(input);
+        }
+        ++i;
+        return pass<token_t>(std::ranges::subrange(i, e), token);
+    }
+};
+
+/// @brief Matches a single token of a given kind
+/// @ingroup ctpc_parsers
+///
+/// Parser signature:
+/// ```
+/// token<Kind> -> Token
+/// ```
+///
+/// Parses the first token of a token input (see `token_input`) if its
+/// `token_kind` equals `KIND`, and fails otherwise. When the kind is an
+/// integer or enumeration, `alt` dispatches on it, so an `alt` of `token`
+/// parsers only tries the alternatives that can match the next token.
+///
+/// ```
+/// static constexpr auto assignment = seq(
+///     token<Kind::identifier>,
+///     token<Kind::equals>,
+///     expression
+/// );
+/// ```
+template <auto KIND>
+static constexpr MatchToken<KIND> token{};
+
+struct TokenIf {
+    template <typename F>
+    constexpr auto operator()(F&& pred) const -> detail::TokenIfParser<F> {
+        return detail::TokenIfParser<F>(std::forward<F>(pred));
+    }
+};
+
+/// @brief Matches a single token satisfying a predicate
+/// @ingroup ctpc_parsers
+///
+/// Parser signature:
+/// ```
+/// token_if(Predicate pred) -> Token
+/// ```
+///
+/// Parses the first token of a token input (see `token_input`) if
+/// `pred(token)` returns true, and fails otherwise.
+///
+/// ```
+/// static constexpr auto literal = token_if([](const Token& tok) {
+///     return tok.kind == Kind::number || tok.kind == Kind::string;
+/// });
+/// ```
+static constexpr TokenIf token_if{};
+
+}
+
+#endif
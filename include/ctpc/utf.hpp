@@ -1,6 +1,9 @@
 #ifndef CTPC_UTF_HPP
 #define CTPC_UTF_HPP
 
+#include <algorithm>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
 #include <optional>
@@ -9,6 +12,7 @@
 
 #include "input.hpp"
 #include "parse_result.hpp"
+#include "simd.hpp"
 
 namespace ctpc {
 
@@ -35,11 +39,84 @@ struct is_text_char<wchar_t> : std::true_type {};
 template <typename T>
 static inline constexpr bool is_text_char_v = is_text_char<T>::value;
 
+namespace detail {
+
+// Returns the number of leading ASCII code units of a contiguous range of
+// one or two byte code units, checking a word or vector at a time.
+template <typename T>
+inline size_t utf_ascii_prefix(const T* data, size_t size) {
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2);
+    size_t i = 0;
+#if defined(CTPC_SIMD_SSE2)
+    if constexpr (sizeof(T) == 1) {
+        for (; i + 16 <= size; i += 16) {
+            auto mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+            if (mask != 0) {
+                return i + static_cast<size_t>(std::countr_zero(static_cast<unsigned>(mask)));
+            }
+        }
+    }
+#endif
+    constexpr uint64_t high_bits = sizeof(T) == 1 ? 0x8080'8080'8080'8080u : 0xFF80'FF80'FF80'FF80u;
+    for (; i + 8 / sizeof(T) <= size; i += 8 / sizeof(T)) {
+        auto word = ctpc::detail::simd::load<uint64_t>(data + i) & high_bits;
+        if (word != 0) {
+            if constexpr (std::endian::native == std::endian::little) {
+                return i + static_cast<size_t>(std::countr_zero(word)) / (8 * sizeof(T));
+            } else {
+                break;
+            }
+        }
+    }
+    for (; i < size; ++i) {
+        auto c = sizeof(T) == 1 ? static_cast<uint32_t>(static_cast<uint8_t>(data[i]))
+                                : static_cast<uint32_t>(static_cast<uint16_t>(data[i]));
+        if (c >= 0x80) {
+            break;
+        }
+    }
+    return i;
+}
+
+}
+
+namespace detail {
+
+// A code unit that may be absent. Unlike `std::optional`, the value is
+// always initialized, so copying an empty one, as every copy of a
+// converting iterator at its end does, does not read uninitialized
+// memory.
+template <typename T>
+struct UtfUnit {
+    T value{};
+    bool engaged{false};
+
+    constexpr bool has_value() const noexcept {
+        return engaged;
+    }
+
+    constexpr T operator*() const noexcept {
+        return value;
+    }
+
+    constexpr void emplace(T unit) noexcept {
+        value = unit;
+        engaged = true;
+    }
+
+    constexpr void reset() noexcept {
+        value = T{};
+        engaged = false;
+    }
+};
+
+}
+
 template <std::forward_iterator I, std::sentinel_for<I> S = I, typename O = char32_t>
 struct Utf8ToUtf32 {
   private:
     std::ranges::subrange<I, S> range_;
-    std::optional<O> curr_{};
+    detail::UtfUnit<O> curr_{};
 
   public:
     using value_type = O;
@@ -68,8 +145,8 @@ struct Utf8ToUtf32 {
             return *this;
         }
 
-        auto c = static_cast<uint32_t>(range_.front());
-        range_ = range_.next();
+        auto c = static_cast<uint32_t>(static_cast<uint8_t>(range_.front()));
+        range_.advance(1);
 
         size_t count = 0;
         if ((c & 0b1000'0000) == 0b0000'0000) {
@@ -98,13 +175,13 @@ struct Utf8ToUtf32 {
                 c = 0xFFFD;
                 break;
             }
-            auto tmp = static_cast<uint32_t>(range_.front());
+            auto tmp = static_cast<uint32_t>(static_cast<uint8_t>(range_.front()));
             if ((tmp & 0b1100'0000) != 0b1000'0000) {
                 c = 0xFFFD;
                 break;
             }
-            c = (c << 6) | tmp;
-            range_ = range_.next();
+            c = (c << 6) | (tmp & 0b0011'1111);
+            range_.advance(1);
             --count;
         }
 
@@ -119,7 +196,10 @@ struct Utf8ToUtf32 {
     }
 
     constexpr std::optional<O> get() const {
-        return curr_;
+        if (!curr_.has_value()) {
+            return std::nullopt;
+        }
+        return *curr_;
     }
 
     friend constexpr bool operator==(const Utf8ToUtf32& lhs, const Utf8ToUtf32& rhs) {
@@ -145,7 +225,7 @@ struct Utf32ToUtf8 {
     std::ranges::subrange<I, S> range_;
     std::array<char8_t, 5> cache_{};
     size_t pos_{5};
-    std::optional<char8_t> curr_{std::nullopt};
+    detail::UtfUnit<char8_t> curr_{};
 
   public:
     using value_type = O;
@@ -178,7 +258,7 @@ struct Utf32ToUtf8 {
         }
 
         auto c = static_cast<uint32_t>(range_.front());
-        range_ = range_.next();
+        range_.advance(1);
 
         if (c < 0x80) {
             curr_.emplace(static_cast<O>(c));
@@ -247,7 +327,7 @@ template <std::forward_iterator I, std::sentinel_for<I> S = I, typename O = char
 struct Utf16ToUtf32 {
   private:
     std::ranges::subrange<I, S> range_;
-    std::optional<O> curr_{std::nullopt};
+    detail::UtfUnit<O> curr_{};
 
   public:
     using value_type = O;
@@ -277,7 +357,7 @@ struct Utf16ToUtf32 {
         }
 
         auto c = static_cast<uint32_t>(range_.front());
-        range_ = range_.next();
+        range_.advance(1);
 
         if ((c & 0b1111'1100'0000'0000) == 0b1101'1000'0000'0000) {
             if (range_.empty()) {
@@ -286,7 +366,7 @@ struct Utf16ToUtf32 {
             }
 
             auto d = static_cast<uint32_t>(range_.front());
-            range_ = range_.next();
+            range_.advance(1);
             if ((d & 0b1111'1100'0000'0000) != 0b1101'1100'0000'0000) {
                 curr_.emplace(static_cast<O>(0xFFFD));
                 return *this;
@@ -329,8 +409,8 @@ template <std::forward_iterator I, std::sentinel_for<I> S = I, typename O = char
 struct Utf32ToUtf16 {
   private:
     std::ranges::subrange<I, S> range_;
-    std::optional<O> next_{std::nullopt};
-    std::optional<O> curr_{std::nullopt};
+    detail::UtfUnit<O> next_{};
+    detail::UtfUnit<O> curr_{};
 
   public:
     using value_type = O;
@@ -364,7 +444,7 @@ struct Utf32ToUtf16 {
         }
 
         auto c = static_cast<uint32_t>(range_.front());
-        range_ = range_.next();
+        range_.advance(1);
 
         if (c < 0x10000) {
             if (c >= 0xD800 && c < 0xE000) {
@@ -477,7 +557,7 @@ struct UtfIdentity {
     }
 
     constexpr UtfIdentity& operator++() {
-        range_ = range_.next();
+        range_.advance(1);
         return *this;
     }
 
@@ -531,7 +611,10 @@ constexpr auto utf_convert_impl(Range&& range) {
 ///   * `sizeof(T) == 4`: UTF-32 (e.g. `char32_t`)
 ///
 /// The output view lazily converts characters from the input range in
-/// order when they are fetched, such as during iteration.
+/// order when they are fetched, such as during iteration. Every character
+/// is decoded in turn, including runs of ASCII. For contiguous input,
+/// `utf_transcode` copies runs of ASCII in bulk, and `utf_is_ascii` checks
+/// whether an input needs converting at all.
 template <typename To, typename Range>
 constexpr auto utf_convert(Range&& range) {
     using from_t = std::remove_cvref_t<std::ranges::range_value_t<Range>>;
@@ -564,6 +647,315 @@ constexpr auto utf_convert(Range&& range) {
     }
 }
 
+enum class UtfStatus {
+    ok,
+    invalid,
+    output_too_small,
+};
+
+/// @brief Result of `utf_transcode`
+struct UtfTranscodeResult {
+    /// @brief Whether the whole input was transcoded, or why not
+    UtfStatus status{UtfStatus::ok};
+    /// @brief Number of input code units consumed
+    size_t read{0};
+    /// @brief Number of output code units written
+    size_t written{0};
+
+    constexpr explicit operator bool() const noexcept {
+        return status == UtfStatus::ok;
+    }
+};
+
+namespace detail {
+
+template <typename T>
+constexpr uint32_t utf_unit(T value) {
+    if constexpr (sizeof(T) == 1) {
+        return static_cast<uint32_t>(static_cast<uint8_t>(value));
+    } else if constexpr (sizeof(T) == 2) {
+        return static_cast<uint32_t>(static_cast<uint16_t>(value));
+    } else {
+        return static_cast<uint32_t>(value);
+    }
+}
+
+// Decodes one code point starting at `in[pos]`, rejecting malformed,
+// overlong, surrogate and out of range encodings. Returns the number of
+// code units read, or 0 if the input is invalid.
+template <typename From>
+constexpr size_t utf_decode(const From* in, size_t size, size_t pos, uint32_t& cp) {
+    auto c = utf_unit(in[pos]);
+    if constexpr (sizeof(From) == 1) {
+        auto cont = [&](size_t idx, uint32_t lo, uint32_t hi) {
+            if (pos + idx >= size) {
+                return false;
+            }
+            auto b = utf_unit(in[pos + idx]);
+            if (b < lo || b > hi) {
+                return false;
+            }
+            cp = (cp << 6) | (b & 0b0011'1111);
+            return true;
+        };
+        if (c < 0x80) {
+            cp = c;
+            return 1;
+        } else if (c < 0xC2) {
+            return 0;
+        } else if (c < 0xE0) {
+            cp = c & 0b0001'1111;
+            return cont(1, 0x80, 0xBF) ? 2 : 0;
+        } else if (c < 0xF0) {
+            cp = c & 0b0000'1111;
+            auto lo = c == 0xE0 ? 0xA0u : 0x80u;
+            auto hi = c == 0xED ? 0x9Fu : 0xBFu;
+            return cont(1, lo, hi) && cont(2, 0x80, 0xBF) ? 3 : 0;
+        } else if (c < 0xF5) {
+            cp = c & 0b0000'0111;
+            auto lo = c == 0xF0 ? 0x90u : 0x80u;
+            auto hi = c == 0xF4 ? 0x8Fu : 0xBFu;
+            return cont(1, lo, hi) && cont(2, 0x80, 0xBF) && cont(3, 0x80, 0xBF) ? 4 : 0;
+        }
+        return 0;
+    } else if constexpr (sizeof(From) == 2) {
+        if (c < 0xD800 || c >= 0xE000) {
+            cp = c;
+            return 1;
+        } else if (c < 0xDC00 && pos + 1 < size) {
+            auto d = utf_unit(in[pos + 1]);
+            if (d >= 0xDC00 && d < 0xE000) {
+                cp = (((c & 0x3FF) << 10) | (d & 0x3FF)) + 0x10000;
+                return 2;
+            }
+        }
+        return 0;
+    } else {
+        if (c > 0x10FFFF || (c >= 0xD800 && c < 0xE000)) {
+            return 0;
+        }
+        cp = c;
+        return 1;
+    }
+}
+
+template <typename To>
+constexpr size_t utf_encoded_size(uint32_t cp) {
+    if constexpr (sizeof(To) == 1) {
+        return cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+    } else if constexpr (sizeof(To) == 2) {
+        return cp < 0x10000 ? 1 : 2;
+    } else {
+        return 1;
+    }
+}
+
+template <typename To>
+constexpr void utf_encode(To* out, uint32_t cp) {
+    if constexpr (sizeof(To) == 1) {
+        if (cp < 0x80) {
+            out[0] = static_cast<To>(cp);
+        } else if (cp < 0x800) {
+            out[0] = static_cast<To>(0xC0 | (cp >> 6));
+            out[1] = static_cast<To>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out[0] = static_cast<To>(0xE0 | (cp >> 12));
+            out[1] = static_cast<To>(0x80 | ((cp >> 6) & 0x3F));
+            out[2] = static_cast<To>(0x80 | (cp & 0x3F));
+        } else {
+            out[0] = static_cast<To>(0xF0 | (cp >> 18));
+            out[1] = static_cast<To>(0x80 | ((cp >> 12) & 0x3F));
+            out[2] = static_cast<To>(0x80 | ((cp >> 6) & 0x3F));
+            out[3] = static_cast<To>(0x80 | (cp & 0x3F));
+        }
+    } else if constexpr (sizeof(To) == 2) {
+        if (cp < 0x10000) {
+            out[0] = static_cast<To>(cp);
+        } else {
+            cp -= 0x10000;
+            out[0] = static_cast<To>(0xD800 | (cp >> 10));
+            out[1] = static_cast<To>(0xDC00 | (cp & 0x3FF));
+        }
+    } else {
+        out[0] = static_cast<To>(cp);
+    }
+}
+
+// Copies the leading run of ASCII code units from `in` to `out`, a block
+// at a time, and returns the number of code units copied. May stop before
+// the end of the run; the caller continues one code point at a time.
+template <typename From, typename To>
+inline size_t utf_ascii_run(const From* in, size_t size, To* out, size_t capacity) {
+    size_t limit = std::min(size, capacity);
+    size_t i = 0;
+    if constexpr (sizeof(From) == 1) {
+#if defined(CTPC_SIMD_SSE2)
+        auto zero = _mm_setzero_si128();
+        for (; i + 16 <= limit; i += 16) {
+            auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            if (_mm_movemask_epi8(v) != 0) {
+                break;
+            }
+            if constexpr (sizeof(To) == 1) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v);
+            } else if constexpr (sizeof(To) == 2) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi8(v, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), _mm_unpackhi_epi8(v, zero));
+            } else {
+                auto lo = _mm_unpacklo_epi8(v, zero);
+                auto hi = _mm_unpackhi_epi8(v, zero);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi16(lo, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), _mm_unpackhi_epi16(lo, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), _mm_unpacklo_epi16(hi, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 12), _mm_unpackhi_epi16(hi, zero));
+            }
+        }
+#else
+        for (; i + 8 <= limit; i += 8) {
+            if ((ctpc::detail::simd::load<uint64_t>(in + i) & 0x8080'8080'8080'8080u) != 0) {
+                break;
+            }
+            for (size_t j = 0; j < 8; ++j) {
+                out[i + j] = static_cast<To>(utf_unit(in[i + j]));
+            }
+        }
+#endif
+    } else if constexpr (sizeof(From) == 2 && sizeof(To) == 1) {
+#if defined(CTPC_SIMD_SSE2)
+        auto mask = _mm_set1_epi16(static_cast<short>(0xFF80));
+        auto zero = _mm_setzero_si128();
+        for (; i + 8 <= limit; i += 8) {
+            auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, mask), zero)) != 0xFFFF) {
+                break;
+            }
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(v, v));
+        }
+#else
+        for (; i + 4 <= limit; i += 4) {
+            if ((ctpc::detail::simd::load<uint64_t>(in + i) & 0xFF80'FF80'FF80'FF80u) != 0) {
+                break;
+            }
+            for (size_t j = 0; j < 4; ++j) {
+                out[i + j] = static_cast<To>(utf_unit(in[i + j]));
+            }
+        }
+#endif
+    }
+    return i;
+}
+
+}
+
+/// @brief The maximum number of `To` code units needed to transcode
+/// `size` code units of type `From`
+template <typename To, typename From>
+constexpr size_t utf_transcode_bound(size_t size) {
+    if constexpr (sizeof(To) == 1 && sizeof(From) == 2) {
+        return size * 3;
+    } else if constexpr (sizeof(To) == 1 && sizeof(From) == 4) {
+        return size * 4;
+    } else if constexpr (sizeof(To) == 2 && sizeof(From) == 4) {
+        return size * 2;
+    } else {
+        return size;
+    }
+}
+
+/// @brief Converts a whole UTF encoded input into a buffer
+///
+/// @details
+/// This is the eager, bulk counterpart of `utf_convert` for contiguous
+/// input and output ranges, with encodings chosen by code unit size in the
+/// same way. Unlike `utf_convert`, the input is validated: transcoding
+/// stops at the first malformed, overlong, surrogate or out of range
+/// encoding with `UtfStatus::invalid`, or with
+/// `UtfStatus::output_too_small` if the next code point does not fit in
+/// `output`. The result records how much input was read and output was
+/// written either way. Output of `utf_transcode_bound` code units always
+/// suffices.
+///
+/// Outside of constant evaluation, runs of ASCII are validated and
+/// converted 16 code units at a time.
+///
+/// ```
+/// std::u16string out(utils::utf_transcode_bound<char16_t, char>(in.size()), u'\0');
+/// auto res = utils::utf_transcode(in, out);
+/// out.resize(res.written);
+/// ```
+template <std::ranges::contiguous_range In, std::ranges::contiguous_range Out>
+    requires std::ranges::sized_range<In> && std::ranges::sized_range<Out>
+constexpr UtfTranscodeResult utf_transcode(const In& input, Out&& output) {
+    using from_t = std::remove_cvref_t<std::ranges::range_value_t<In>>;
+    using to_t = std::ranges::range_value_t<Out>;
+    static_assert(sizeof(from_t) == 1 || sizeof(from_t) == 2 || sizeof(from_t) == 4);
+    static_assert(sizeof(to_t) == 1 || sizeof(to_t) == 2 || sizeof(to_t) == 4);
+
+    const from_t* in = std::ranges::data(input);
+    to_t* out = std::ranges::data(output);
+    auto size = static_cast<size_t>(std::ranges::size(input));
+    auto capacity = static_cast<size_t>(std::ranges::size(output));
+
+    UtfTranscodeResult res{};
+    while (res.read < size) {
+        if constexpr (sizeof(from_t) == 1 || (sizeof(from_t) == 2 && sizeof(to_t) == 1)) {
+            if (!std::is_constant_evaluated() && detail::utf_unit(in[res.read]) < 0x80) {
+                auto count = detail::utf_ascii_run(in + res.read, size - res.read, out + res.written, capacity - res.written);
+                res.read += count;
+                res.written += count;
+                if (res.read == size) {
+                    break;
+                }
+            }
+        }
+        uint32_t cp = 0;
+        auto len = detail::utf_decode(in, size, res.read, cp);
+        if (len == 0) {
+            res.status = UtfStatus::invalid;
+            return res;
+        }
+        auto out_len = detail::utf_encoded_size<to_t>(cp);
+        if (capacity - res.written < out_len) {
+            res.status = UtfStatus::output_too_small;
+            return res;
+        }
+        detail::utf_encode(out + res.written, cp);
+        res.read += len;
+        res.written += out_len;
+    }
+    return res;
+}
+
+/// @brief Whether every code unit of a UTF encoded input is ASCII
+///
+/// @details
+/// An all ASCII input has the same code units in every UTF encoding, so a
+/// parser can check this once and then work on code units directly
+/// instead of converting. Contiguous inputs of one or two byte code units
+/// are checked a vector or word at a time outside of constant evaluation.
+///
+/// ```
+/// if (utils::utf_is_ascii(input)) {
+///     return ascii_parser(input);
+/// }
+/// return unicode_parser(utils::utf_convert<char32_t>(input));
+/// ```
+template <std::ranges::forward_range R>
+constexpr bool utf_is_ascii(const R& input) {
+    using unit_t = std::remove_cvref_t<std::ranges::range_value_t<R>>;
+    if constexpr (std::ranges::contiguous_range<R> && std::ranges::sized_range<R> && sizeof(unit_t) <= 2) {
+        if (!std::is_constant_evaluated()) {
+            auto size = static_cast<size_t>(std::ranges::size(input));
+            return detail::utf_ascii_prefix(std::ranges::data(input), size) == size;
+        }
+    }
+    for (const auto& c : input) {
+        if (detail::utf_unit(c) >= 0x80) {
+            return false;
+        }
+    }
+    return true;
+}
 }
 
 template <typename Char>
@@ -1,10 +1,15 @@
 #ifndef CTPC_UTILS_HPP
 #define CTPC_UTILS_HPP
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <functional>
+#include <ranges>
 #include <type_traits>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #define CTPC_F(name) \
     [](auto&&... args) -> decltype(auto) { \
@@ -63,12 +68,78 @@ constexpr decltype(auto) invoke_unpacked(F&& func, Args&&... args) {
     return invoke_with_tuple(std::forward<F>(func), std::tuple_cat(into_tuple(std::forward<Args>(args))...));
 }
 
+// Passed first to a reducer to ask it to fold an item into the
+// accumulator in place (see `InPlaceReduce`), so that in place overloads
+// never compete with by-value overloads for lvalue accumulators.
+struct ReduceInPlace {};
+
+static constexpr ReduceInPlace reduce_in_place{};
+
+namespace detail {
+
+template <typename F, typename Args>
+struct unpacked_invoke_result {};
+
+template <typename F, typename... Args>
+    requires std::is_invocable_v<F, Args&&...>
+struct unpacked_invoke_result<F, std::tuple<Args...>> {
+    using type = std::invoke_result_t<F, Args&&...>;
+};
+
+template <typename A, typename Item>
+using reduce_args_t = decltype(std::tuple_cat(
+    into_tuple(std::declval<const ReduceInPlace&>()),
+    into_tuple(std::declval<A&>()),
+    into_tuple(std::declval<Item>())
+));
+
+}
+
+// Whether `reduce` can fold an item into an accumulator in place, when
+// invoked as `reduce(reduce_in_place, accum&, item...)` and returning
+// `void`, instead of taking the accumulator by value and returning the new
+// accumulator.
+template <typename R, typename A, typename Item>
+concept InPlaceReduce = requires {
+    typename detail::unpacked_invoke_result<R, detail::reduce_args_t<A, Item>>::type;
+} && std::is_void_v<typename detail::unpacked_invoke_result<R, detail::reduce_args_t<A, Item>>::type>;
+
+// Folds an item into an accumulator with `reduce`, in place if `reduce`
+// supports it (see `InPlaceReduce`), or otherwise by moving the
+// accumulator through `reduce` and assigning back the result.
+template <typename R, typename A, typename Item>
+constexpr void reduce_into(R&& reduce, A& accum, Item&& item) {
+    if constexpr (InPlaceReduce<R, A, Item>) {
+        invoke_unpacked(std::forward<R>(reduce), reduce_in_place, accum, std::forward<Item>(item));
+    } else {
+        accum = invoke_unpacked(std::forward<R>(reduce), std::move(accum), std::forward<Item>(item));
+    }
+}
+
 struct DefaultReduce {
+    // Bytes reserved when the first item is added, so that short lists are
+    // allocated once instead of growing one element at a time.
+    static constexpr size_t initial_bytes = 256;
+
+    // Capacity reserved for the first item, at most 8 and at least 1
+    template <typename T>
+    static constexpr size_t initial_capacity = std::clamp<size_t>(initial_bytes / sizeof(T), 1, 8);
+
     template <typename Item>
     constexpr std::vector<std::remove_cvref_t<Item>> operator()(std::vector<std::remove_cvref_t<Item>> accum, Item&& item) const {
-        accum.emplace_back(std::forward<Item>(item));
+        (*this)(reduce_in_place, accum, std::forward<Item>(item));
         return accum;
     }
+
+    template <typename Item, typename Alloc>
+    constexpr void operator()([[maybe_unused]] ReduceInPlace tag, std::vector<std::remove_cvref_t<Item>, Alloc>& accum, Item&& item) const {
+        // A vector that already has capacity, such as one reserved from a
+        // size hint, is left as is
+        if (accum.capacity() == 0) {
+            accum.reserve(initial_capacity<std::remove_cvref_t<Item>>);
+        }
+        accum.emplace_back(std::forward<Item>(item));
+    }
 };
 
 static constexpr DefaultReduce default_reduce{};
@@ -82,6 +153,69 @@ concept Reservable = requires(T container) {
     container.reserve(size_t{42});
 };
 
+// Placeholder for combinators that were not given a size hint.
+struct NoSizeHint {};
+
+// Evaluates a size hint for `input`, capped at the size of `input`, since
+// each item of a list consumes at least one element.
+template <typename H, typename I>
+constexpr size_t size_hint(const H& hint, const I& input) {
+    auto count = static_cast<size_t>(std::invoke(hint, input));
+    if constexpr (std::ranges::sized_range<I>) {
+        count = std::min(count, static_cast<size_t>(std::ranges::size(input)));
+    }
+    return count;
+}
+
+template <typename T>
+struct CountOf {
+    T value;
+
+    template <std::ranges::forward_range I>
+    constexpr size_t operator()(const I& input) const {
+        using elem_t = std::remove_cvref_t<std::ranges::range_value_t<I>>;
+        if constexpr (std::ranges::contiguous_range<I> && std::ranges::sized_range<I> &&
+                      sizeof(elem_t) == 1 && std::is_trivially_copyable_v<elem_t> &&
+                      requires(const T& v) { static_cast<unsigned char>(static_cast<elem_t>(v)); }) {
+            if (!std::is_constant_evaluated()) {
+                // Search for `value` as an element, and only if converting
+                // it to one is lossless, so that the count matches
+                // `std::ranges::count`.
+                auto elem = static_cast<elem_t>(value);
+                if (!(elem == value)) {
+                    return 0;
+                }
+                auto c = static_cast<unsigned char>(elem);
+                auto data = reinterpret_cast<const unsigned char*>(std::ranges::data(input));
+                auto end = data + std::ranges::size(input);
+                size_t count = 0;
+                while (data != end) {
+                    auto found = static_cast<const unsigned char*>(std::memchr(data, c, static_cast<size_t>(end - data)));
+                    if (found == nullptr) {
+                        break;
+                    }
+                    ++count;
+                    data = found + 1;
+                }
+                return count;
+            }
+        }
+        return static_cast<size_t>(std::ranges::count(input, value));
+    }
+};
+
+struct MakeCountOf {
+    template <typename T>
+    constexpr auto operator()(T value) const -> CountOf<T> {
+        return CountOf<T>{value};
+    }
+};
+
+// Size hint counting the occurrences of an element, such as the
+// separator or terminator of list items, using `memchr` for single byte
+// elements.
+static constexpr MakeCountOf count_of{};
+
 struct DefaultInit {
     template <typename T>
     constexpr operator T() const {
@@ -11,32 +11,127 @@
 #include "parser.hpp"
 #include "parse_result.hpp"
 #include "const_input.hpp"
+#include "first_set.hpp"
+#include "error.hpp"
+#include "simd.hpp"
 #include "utf.hpp"
 
 namespace ctpc {
 
+namespace detail {
+
+template <typename I, typename T>
+concept VerbatimFastInput = std::ranges::contiguous_range<I> &&
+                            std::ranges::sized_range<I> &&
+                            CodeUnit<T> &&
+                            std::is_same_v<std::remove_cvref_t<std::ranges::range_value_t<I>>, T>;
+
+// Compares the start of a contiguous input against `match` with wide
+// loads. Returns the remaining input on success.
+template <typename I, typename T>
+constexpr std::optional<std::ranges::subrange<std::ranges::iterator_t<I>, std::ranges::sentinel_t<I>>>
+verbatim_fast_match(I& input, const T* match, size_t len) {
+    if (std::ranges::size(input) < len) {
+        return std::nullopt;
+    }
+    if (!simd::equal(std::ranges::data(input), match, len * sizeof(T))) {
+        return std::nullopt;
+    }
+    return std::ranges::subrange(std::ranges::next(std::ranges::begin(input), static_cast<std::ranges::range_difference_t<I>>(len)),
+                                 std::ranges::end(input));
+}
+
+// Whether a contiguous input that is shorter than `match` is a prefix of it.
+template <typename I, typename T>
+constexpr bool verbatim_fast_prefix(I& input, const T* match, size_t len) {
+    auto size = std::ranges::size(input);
+    return size < len && simd::equal(std::ranges::data(input), match, size * sizeof(T));
+}
+
+// The name `verbatim<MATCH>` reports to an error context: the quoted text
+// for text, and the elements in hexadecimal otherwise.
+template <ConstInput MATCH>
+inline constexpr std::string_view verbatim_error_name = error_name<[](ErrorNameWriter& writer) {
+    using value_type = typename std::remove_cvref_t<decltype(MATCH)>::value_type;
+    if constexpr (utils::is_text_char_v<value_type>) {
+        writer.put('"');
+        for (auto c : utils::utf_convert<char32_t>(std::ranges::subrange(std::ranges::begin(MATCH), std::ranges::end(MATCH) - 1))) {
+            writer.put_utf8(static_cast<uint32_t>(c));
+        }
+        writer.put('"');
+    } else if constexpr (CodeUnit<value_type>) {
+        writer.put('<');
+        for (size_t i = 0; i < MATCH.length; ++i) {
+            if (i != 0) {
+                writer.put(' ');
+            }
+            writer.put_hex(code_unit(MATCH.input[i]), sizeof(value_type) * 2);
+        }
+        writer.put('>');
+    } else {
+        for (auto c : std::string_view{"<verbatim>"}) {
+            writer.put(c);
+        }
+    }
+}>;
+
+}
+
 template <ConstInput MATCH, typename = void>
 struct Verbatim {
     using match_type = std::remove_cvref_t<decltype(MATCH)>;
 
+    template <typename Elem>
+    static constexpr std::optional<detail::FirstSet> first_set() {
+        if constexpr (std::is_same_v<Elem, typename match_type::value_type> &&
+                      detail::CodeUnit<Elem> &&
+                      match_type::length != 0) {
+            detail::FirstSet set{};
+            set.insert(detail::code_unit(MATCH.input[0]));
+            return set;
+        } else {
+            return std::nullopt;
+        }
+    }
+
     template <InputOf<typename std::remove_cvref_t<decltype(MATCH)>::value_type> I>
     constexpr auto operator()(I input) const {
-        using ret_t = std::span<typename match_type::value_type, match_type::length>;
-        std::ranges::subrange in{input};
+        using ret_t = std::span<const typename match_type::value_type, match_type::length>;
         ret_t match{MATCH.input};
+        if constexpr (detail::VerbatimFastInput<I, typename match_type::value_type>) {
+            if (!std::is_constant_evaluated()) {
+                if (auto rem = detail::verbatim_fast_match(input, match.data(), match.size())) {
+                    return pass<ret_t>(*rem, match);
+                }
+                if constexpr (StreamingInput<I>) {
+                    if (detail::verbatim_fast_prefix(input, match.data(), match.size())) {
+                        return incomplete<ret_t>(input, match.size() - std::ranges::size(input));
+                    }
+                }
+                detail::report_expected(input, detail::verbatim_error_name<MATCH>);
+                return fail<ret_t>(input);
+            }
+        }
+        std::ranges::subrange in{input};
         auto ibegin = std::ranges::begin(in);
         auto iend = std::ranges::end(in);
         auto mbegin = std::ranges::begin(match);
         auto mend = std::ranges::end(match);
         while (ibegin != iend && mbegin != mend) {
             if (*ibegin != *mbegin) {
+                detail::report_expected(input, detail::verbatim_error_name<MATCH>);
                 return fail<ret_t>(input);
             }
             ++ibegin;
             ++mbegin;
         }
         if (mbegin != mend) {
-            return fail<ret_t>(input);
+            if constexpr (StreamingInput<I>) {
+                return incomplete<ret_t>(input, static_cast<size_t>(std::ranges::distance(mbegin, mend)));
+            } else {
+                detail::report_expected(input, detail::verbatim_error_name<MATCH>);
+                return fail<ret_t>(input);
+            }
         }
         return pass<ret_t>(
             std::ranges::subrange(ibegin, iend),
@@ -75,25 +170,63 @@ struct Verbatim<MATCH, std::enable_if_t<utils::is_text_char_v<typename std::remo
     template <typename To>
     static constexpr auto converted_match = detail::verbatim_convert<To, detail::verbatim_converted_size<To>(MATCH) + 1>(MATCH);
 
+    template <typename Elem>
+    static constexpr std::optional<detail::FirstSet> first_set() {
+        if constexpr (utils::is_text_char_v<Elem>) {
+            if constexpr (converted_match<Elem>.size() > 1) {
+                detail::FirstSet set{};
+                set.insert(detail::code_unit(converted_match<Elem>[0]));
+                return set;
+            } else {
+                return std::nullopt;
+            }
+        } else {
+            return std::nullopt;
+        }
+    }
+
     template <TextInput I>
     constexpr ParseResultOf<std::basic_string_view<std::remove_cvref_t<decltype(*std::ranges::begin(std::declval<I>()))>>, I>
     operator()(I input) const {
         using input_char = std::remove_cvref_t<decltype(*std::ranges::begin(input))>;
+        std::basic_string_view<input_char> match{
+            converted_match<input_char>.data(),
+            converted_match<input_char>.size() - 1
+        };
+        if constexpr (detail::VerbatimFastInput<I, input_char>) {
+            if (!std::is_constant_evaluated()) {
+                if (auto rem = detail::verbatim_fast_match(input, match.data(), match.size())) {
+                    return pass<std::basic_string_view<input_char>>(*rem, match);
+                }
+                if constexpr (StreamingInput<I>) {
+                    if (detail::verbatim_fast_prefix(input, match.data(), match.size())) {
+                        return incomplete<std::basic_string_view<input_char>>(input, match.size() - std::ranges::size(input));
+                    }
+                }
+                detail::report_expected(input, detail::verbatim_error_name<MATCH>);
+                return fail<std::basic_string_view<input_char>>(input);
+            }
+        }
         std::ranges::subrange in{input};
-        std::basic_string_view<input_char> match{converted_match<input_char>.data()};
         auto ibegin = std::ranges::begin(in);
         auto iend = std::ranges::end(in);
         auto mbegin = std::ranges::begin(match);
         auto mend = std::ranges::end(match);
         while (ibegin != iend && mbegin != mend) {
             if (*ibegin != *mbegin) {
+                detail::report_expected(input, detail::verbatim_error_name<MATCH>);
                 return fail<std::basic_string_view<input_char>>(input);
             }
             ++ibegin;
             ++mbegin;
         }
         if (mbegin != mend) {
-            return fail<std::basic_string_view<input_char>>(input);
+            if constexpr (StreamingInput<I>) {
+                return incomplete<std::basic_string_view<input_char>>(input, static_cast<size_t>(std::ranges::distance(mbegin, mend)));
+            } else {
+                detail::report_expected(input, detail::verbatim_error_name<MATCH>);
+                return fail<std::basic_string_view<input_char>>(input);
+            }
         }
         return pass<std::basic_string_view<input_char>>(
             std::ranges::subrange(ibegin, iend),
@@ -0,0 +1,69 @@
+#include <ctpc/alt.hpp>
+#include <ctpc/map.hpp>
+#include <ctpc/regex_match.hpp>
+#include <ctpc/verbatim.hpp>
+#include "test_utils.hpp"
+
+using namespace ctpc;
+
+static constexpr auto method = alt(
+    map(verbatim<"GET">, [](auto) { return 1; }),
+    map(verbatim<"POST">, [](auto) { return 2; }),
+    map(regex_match<"\\d+">, [](auto) { return 3; }),
+    map(regex_match<"\\s*x">, [](auto) { return 4; })
+);
+
+TEST_CASE("first alternative", "[alt]") {
+    auto res = method("GET /"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == 1);
+    REQUIRE(res.remaining() == " /"sv);
+}
+
+TEST_CASE("dispatched alternative", "[alt]") {
+    auto res = method("POST /"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == 2);
+    REQUIRE(res.remaining() == " /"sv);
+}
+
+TEST_CASE("regex alternative", "[alt]") {
+    auto res = method("123 "sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == 3);
+    REQUIRE(res.remaining() == " "sv);
+}
+
+TEST_CASE("opaque alternative", "[alt]") {
+    auto res = method("  x"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == 4);
+    REQUIRE(res.remaining() == ""sv);
+}
+
+TEST_CASE("no alternative", "[alt]") {
+    auto res = method("GEX"sv);
+    REQUIRE(res.passed() == false);
+    REQUIRE(res.remaining() == "GEX"sv);
+}
+
+TEST_CASE("empty input", "[alt]") {
+    auto res = method(""sv);
+    REQUIRE(res.passed() == false);
+}
+
+TEST_CASE("wide input", "[alt]") {
+    REQUIRE(*method(u"POST"sv) == 2);
+    REQUIRE(*method(U"12"sv) == 3);
+    REQUIRE(method(U"é"sv).passed() == false);
+}
+
+TEST_CASE("regex first set", "[alt]") {
+    STATIC_REQUIRE(detail::regex_first_set(ctll::fixed_string{"\\d+"})->contains('5'));
+    STATIC_REQUIRE(!detail::regex_first_set(ctll::fixed_string{"\\d+"})->contains('a'));
+    STATIC_REQUIRE(!detail::regex_first_set(ctll::fixed_string{"\\s*"}).has_value());
+    STATIC_REQUIRE(!detail::regex_first_set(ctll::fixed_string{"a|b"}).has_value());
+    STATIC_REQUIRE(!detail::regex_first_set(ctll::fixed_string{"a{0,2}"}).has_value());
+    STATIC_REQUIRE(detail::regex_first_set(ctll::fixed_string{"[^a-c]x"})->contains('d'));
+    STATIC_REQUIRE(!detail::regex_first_set(ctll::fixed_string{"[^a-c]x"})->contains('b'));
+}
@@ -0,0 +1,93 @@
+#include <ctpc/arena.hpp>
+#include <ctpc/count.hpp>
+#include <ctpc/delimited.hpp>
+#include <ctpc/integer.hpp>
+#include <ctpc/many0.hpp>
+#include <ctpc/map.hpp>
+#include <ctpc/regex_match.hpp>
+#include <ctpc/terminated.hpp>
+#include <ctpc/utils.hpp>
+#include <ctpc/verbatim.hpp>
+#include <string_view>
+#include "test_utils.hpp"
+
+using namespace ctpc;
+
+static constexpr auto word = terminated(regex_match<"\\w+">, regex_match<" *">);
+static constexpr auto words = many0(word, arena_vector, utils::default_reduce_init);
+static constexpr auto lists = many0(
+    delimited(verbatim<"(">, words, verbatim<")">),
+    arena_vector,
+    utils::default_reduce_init
+);
+
+TEST_CASE("arena allocation", "[arena]") {
+    Arena arena{128};
+    REQUIRE(arena.used() == 0);
+    auto* a = static_cast<uint64_t*>(arena.allocate(sizeof(uint64_t), alignof(uint64_t)));
+    auto* b = static_cast<std::byte*>(arena.allocate(1, 1));
+    auto* c = static_cast<uint32_t*>(arena.allocate(sizeof(uint32_t), alignof(uint32_t)));
+    REQUIRE(reinterpret_cast<uintptr_t>(a) % alignof(uint64_t) == 0);
+    REQUIRE(reinterpret_cast<uintptr_t>(c) % alignof(uint32_t) == 0);
+    REQUIRE(b == reinterpret_cast<std::byte*>(a + 1));
+    REQUIRE(arena.used() == 13);
+
+    // Larger than a block
+    auto* big = static_cast<std::byte*>(arena.allocate(4096, 64));
+    REQUIRE(reinterpret_cast<uintptr_t>(big) % 64 == 0);
+    big[4095] = std::byte{1};
+
+    arena.release();
+    REQUIRE(arena.used() == 0);
+}
+
+TEST_CASE("arena vector in parse", "[arena]") {
+    Arena arena{};
+    auto res = parse_with_arena(words, "alpha beta gamma"sv, arena);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->size() == 3);
+    REQUIRE((*res)[2] == "gamma"sv);
+    REQUIRE(res->get_allocator().arena() == &arena);
+    REQUIRE(arena.used() > 0);
+}
+
+TEST_CASE("nested arena vectors", "[arena]") {
+    Arena arena{};
+    auto res = parse_with_arena(lists, "(a b)(c)()(d e f)"sv, arena);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->size() == 4);
+    REQUIRE((*res)[0].size() == 2);
+    REQUIRE((*res)[2].empty());
+    REQUIRE((*res)[3][2] == "f"sv);
+    REQUIRE((*res)[3].get_allocator().arena() == &arena);
+}
+
+TEST_CASE("arena vector without arena", "[arena]") {
+    auto res = words("one two"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->size() == 2);
+    REQUIRE(res->get_allocator().arena() == nullptr);
+
+    Arena arena{};
+    {
+        auto inner = parse_with_arena(words, "x"sv, arena);
+        REQUIRE(inner->get_allocator().arena() == &arena);
+    }
+    // The arena is only installed during the parse
+    REQUIRE(words("y"sv)->get_allocator().arena() == nullptr);
+}
+
+TEST_CASE("arena vector with count", "[arena]") {
+    static constexpr auto bytes = count(uint8, 4, arena_vector, utils::default_reduce_init);
+    static constexpr std::array<uint8_t, 5> data{1, 2, 3, 4, 5};
+    Arena arena{};
+    auto res = parse_with_arena(bytes, std::span{data}, arena);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->size() == 4);
+    REQUIRE(res->capacity() == 4);
+    REQUIRE((*res)[3] == 4);
+}
+
+TEST_CASE("arena vector constant evaluation", "[arena]") {
+    STATIC_REQUIRE(many0(verbatim<"ab">, arena_vector, utils::default_reduce_init)("ababa"sv)->size() == 2);
+}
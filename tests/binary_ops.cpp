@@ -0,0 +1,84 @@
+#include <ctpc/binary_ops.hpp>
+#include <ctpc/verbatim.hpp>
+#include "test_utils.hpp"
+
+#include <cstdint>
+#include <string>
+
+using namespace ctpc;
+
+static constexpr auto digit = [](Input auto input) {
+    auto begin = std::ranges::begin(input);
+    auto end = std::ranges::end(input);
+    if (begin == end || *begin < '0' || *begin > '9') {
+        return fail<int64_t>(input);
+    }
+    auto value = static_cast<int64_t>(*begin - '0');
+    ++begin;
+    return pass<int64_t>(std::ranges::subrange(begin, end), value);
+};
+
+static constexpr auto calc = binary_ops(
+    digit,
+    left_assoc(1, verbatim<"+">, [](int64_t lhs, int64_t rhs) { return lhs + rhs; }),
+    left_assoc(1, verbatim<"-">, [](int64_t lhs, int64_t rhs) { return lhs - rhs; }),
+    left_assoc(2, verbatim<"*">, [](int64_t lhs, int64_t rhs) { return lhs * rhs; }),
+    left_assoc(2, verbatim<"/">, [](int64_t lhs, int64_t rhs) { return lhs / rhs; }),
+    right_assoc(3, verbatim<"^">, [](int64_t lhs, int64_t rhs) {
+        int64_t ret = 1;
+        for (int64_t i = 0; i < rhs; ++i) {
+            ret *= lhs;
+        }
+        return ret;
+    })
+);
+
+TEST_CASE("single operand", "[binary_ops]") {
+    auto res = calc("7"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == 7);
+    REQUIRE(res.remaining() == ""sv);
+}
+
+TEST_CASE("no operand", "[binary_ops]") {
+    auto res = calc("+1"sv);
+    REQUIRE(res.passed() == false);
+    REQUIRE(res.remaining() == "+1"sv);
+}
+
+TEST_CASE("precedence", "[binary_ops]") {
+    REQUIRE(*calc("1+2*3"sv) == 7);
+    REQUIRE(*calc("2*3+1"sv) == 7);
+    REQUIRE(*calc("1+2*3^2-4"sv) == 15);
+}
+
+TEST_CASE("left associativity", "[binary_ops]") {
+    REQUIRE(*calc("9-3-2"sv) == 4);
+    REQUIRE(*calc("8/4/2"sv) == 1);
+}
+
+TEST_CASE("right associativity", "[binary_ops]") {
+    REQUIRE(*calc("2^3^2"sv) == 512);
+}
+
+TEST_CASE("trailing operator", "[binary_ops]") {
+    auto res = calc("1+2+"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == 3);
+    REQUIRE(res.remaining() == "+"sv);
+}
+
+TEST_CASE("long chain", "[binary_ops]") {
+    std::string input = "1";
+    for (size_t i = 0; i < 100000; ++i) {
+        input += "+1";
+    }
+    auto res = calc(std::string_view{input});
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == 100001);
+    REQUIRE(res.remaining().empty());
+}
+
+TEST_CASE("constexpr", "[binary_ops]") {
+    STATIC_REQUIRE(*calc("2*3^2+4/2"sv) == 20);
+}
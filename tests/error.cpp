@@ -0,0 +1,117 @@
+#include <ctpc/alt.hpp>
+#include <ctpc/error.hpp>
+#include <ctpc/many0.hpp>
+#include <ctpc/regex_match.hpp>
+#include <ctpc/seq.hpp>
+#include <ctpc/verbatim.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include "test_utils.hpp"
+
+using namespace ctpc;
+
+static constexpr auto value = alt(
+    regex_match<"[0-9]+">,
+    verbatim<"true">,
+    verbatim<"null">
+);
+static constexpr auto pair = seq(regex_match<"[a-z]+">, verbatim<"=">, value, verbatim<";">);
+
+TEST_CASE("parse_with_errors furthest failure", "[error]") {
+    ErrorContext errors{};
+    auto res = parse_with_errors(pair, "key=nope;"sv, errors);
+    REQUIRE(res.passed() == false);
+    REQUIRE(res.remaining() == "key=nope;"sv);
+    REQUIRE(errors.failed() == true);
+    REQUIRE(errors.offset() == 4);
+    REQUIRE(errors.expected().size() == 3);
+    for (auto name : {"[0-9]+"sv, "\"true\""sv, "\"null\""sv}) {
+        REQUIRE(std::ranges::find(errors.expected(), name) != errors.expected().end());
+    }
+
+    auto skipped = parse_with_errors(pair, "key=x;"sv, errors);
+    REQUIRE(skipped.passed() == false);
+    REQUIRE(errors.offset() == 4);
+    REQUIRE(errors.expected().size() == 3);
+
+    auto late = parse_with_errors(pair, "key=12,"sv, errors);
+    REQUIRE(late.passed() == false);
+    REQUIRE(errors.offset() == 6);
+    REQUIRE(errors.expected().size() == 1);
+    REQUIRE(errors.expected()[0] == "\";\""sv);
+}
+
+TEST_CASE("parse_with_errors on success", "[error]") {
+    static constexpr auto pairs = many0(pair, [](size_t count, auto&&...) { return count + 1; }, size_t{0});
+    ErrorContext errors{};
+    auto res = parse_with_errors(pairs, "a=1;b=true;c=null;d"sv, errors);
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == 3);
+    REQUIRE(res.remaining() == "d"sv);
+    REQUIRE(errors.offset() == 19);
+    REQUIRE(errors.expected().size() == 1);
+    REQUIRE(errors.expected()[0] == "\"=\""sv);
+}
+
+TEST_CASE("error names", "[error]") {
+    REQUIRE(detail::verbatim_error_name<"héllo"> == "\"héllo\""sv);
+    REQUIRE(detail::verbatim_error_name<u"wide"> == "\"wide\""sv);
+    static constexpr uint8_t magic[] = {0x7f, 0x45, 0x0a};
+    REQUIRE(detail::verbatim_error_name<ConstInput(magic)> == "<7f 45 0a>"sv);
+    REQUIRE(detail::regex_error_name<"[a-z]+"> == "[a-z]+"sv);
+}
+
+TEST_CASE("error binary input", "[error]") {
+    static constexpr uint8_t magic[] = {0x7f, 0x45, 0x4c};
+    static constexpr auto header = verbatim<ConstInput(magic)>;
+    static constexpr std::array<uint8_t, 4> data{0x7f, 0x45, 0x00, 0x00};
+    ErrorContext errors{};
+    auto res = parse_with_errors(header, std::span{data}, errors);
+    REQUIRE(res.passed() == false);
+    REQUIRE(errors.offset() == 0);
+    REQUIRE(errors.expected()[0] == "<7f 45 4c>"sv);
+}
+
+TEST_CASE("error context not installed", "[error]") {
+    ErrorContext errors{};
+    REQUIRE(pair("key=nope;"sv).passed() == false);
+    REQUIRE(errors.failed() == false);
+    REQUIRE(detail::current_error_context == nullptr);
+
+    auto res = parse_with_errors(pair, "k=1;"sv, errors);
+    REQUIRE(res.passed() == true);
+    REQUIRE(detail::current_error_context == nullptr);
+}
+
+// Fails without a known first set, so `alt` always tries it, and counts
+// how often it is called
+struct CountedFail {
+    static inline size_t calls = 0;
+
+    auto operator()(std::string_view input) const {
+        ++calls;
+        return fail<std::string_view>(input);
+    }
+};
+
+TEST_CASE("error reporting runs each alternative once", "[error]") {
+    static constexpr auto nested = alt(
+        alt(
+            alt(CountedFail{}, verbatim<"a">),
+            verbatim<"b">
+        ),
+        verbatim<"c">
+    );
+
+    CountedFail::calls = 0;
+    REQUIRE(nested("x"sv).passed() == false);
+    REQUIRE(CountedFail::calls == 1);
+
+    ErrorContext errors{};
+    CountedFail::calls = 0;
+    REQUIRE(parse_with_errors(nested, "x"sv, errors).passed() == false);
+    REQUIRE(CountedFail::calls == 1);
+    REQUIRE(errors.expected().size() == 3);
+}
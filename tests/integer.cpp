@@ -0,0 +1,157 @@
+#include <ctpc/integer.hpp>
+#include "test_utils.hpp"
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <span>
+
+using namespace ctpc;
+
+static constexpr std::array<uint8_t, 9> bytes{0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09};
+
+TEST_CASE("uint8", "[integer]") {
+    auto res = uint8(std::span{bytes});
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == 0x01);
+    REQUIRE(std::ranges::size(res.remaining()) == 8);
+}
+
+TEST_CASE("uint16 big endian", "[integer]") {
+    auto res = uint16_be(std::span{bytes});
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == 0x0102);
+    REQUIRE(std::ranges::size(res.remaining()) == 7);
+}
+
+TEST_CASE("uint16 little endian", "[integer]") {
+    auto res = uint16_le(std::span{bytes});
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == 0x0201);
+}
+
+TEST_CASE("uint32 big endian", "[integer]") {
+    REQUIRE(*uint32_be(std::span{bytes}) == 0x01020304);
+}
+
+TEST_CASE("uint32 little endian", "[integer]") {
+    REQUIRE(*uint32_le(std::span{bytes}) == 0x04030201);
+}
+
+TEST_CASE("uint64 big endian", "[integer]") {
+    auto res = uint64_be(std::span{bytes});
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == 0x0102030405060708);
+    REQUIRE(std::ranges::size(res.remaining()) == 1);
+}
+
+TEST_CASE("uint64 little endian", "[integer]") {
+    REQUIRE(*uint64_le(std::span{bytes}) == 0x0807060504030201);
+}
+
+TEST_CASE("int16 negative", "[integer]") {
+    static constexpr std::array<uint8_t, 2> neg{0xFF, 0xFE};
+    REQUIRE(*int16_be(std::span{neg}) == -2);
+}
+
+TEST_CASE("insufficient input", "[integer]") {
+    auto res = uint64_be(std::span{bytes}.first(7));
+    REQUIRE(res.passed() == false);
+    REQUIRE(std::ranges::size(res.remaining()) == 7);
+}
+
+TEST_CASE("non-contiguous input", "[integer]") {
+    std::list<uint8_t> list(bytes.begin(), bytes.end());
+    auto res = uint32_be(std::ranges::subrange(list.begin(), list.end()));
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == 0x01020304);
+    REQUIRE(*std::ranges::begin(res.remaining()) == 0x05);
+}
+
+TEST_CASE("constexpr", "[integer]") {
+    STATIC_REQUIRE(*uint32_be(std::span{bytes}) == 0x01020304);
+    STATIC_REQUIRE(*uint32_le(std::span{bytes}) == 0x04030201);
+    STATIC_REQUIRE(utils::byteswap(uint16_t{0x0102}) == 0x0201);
+}
+
+TEST_CASE("uleb128", "[integer]") {
+    static constexpr std::array<uint8_t, 12> data{0xE5, 0x8E, 0x26, 0x7F, 0x80, 0x01, 0x00, 0x02, 0x03, 0x04, 0x05, 0x06};
+    std::span in{data};
+    auto res = uleb128<uint64_t>(in);
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == 624485);
+    REQUIRE(std::ranges::size(res.remaining()) == 9);
+    auto next = uleb128<uint32_t>(res.remaining());
+    REQUIRE(*next == 0x7F);
+    REQUIRE(*uleb128<uint16_t>(next.remaining()) == 0x80);
+
+    // Shorter than eight bytes, so decoded one byte at a time
+    REQUIRE(*uleb128<uint64_t>(in.subspan(4, 3)) == 0x80);
+    STATIC_REQUIRE(*uleb128<uint64_t>(std::span{data}) == 624485);
+
+    std::list<uint8_t> list(data.begin(), data.end());
+    REQUIRE(*uleb128<uint64_t>(std::ranges::subrange(list.begin(), list.end())) == 624485);
+}
+
+TEST_CASE("uleb128 limits", "[integer]") {
+    static constexpr std::array<uint8_t, 12> max64{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x00, 0x00};
+    auto res = uleb128<uint64_t>(std::span{max64});
+    REQUIRE(*res == UINT64_MAX);
+    REQUIRE(std::ranges::size(res.remaining()) == 2);
+    STATIC_REQUIRE(*uleb128<uint64_t>(std::span{max64}) == UINT64_MAX);
+
+    // A value past 64 bits, and an encoding longer than ten bytes
+    static constexpr std::array<uint8_t, 12> over{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0x00, 0x00};
+    static constexpr std::array<uint8_t, 12> longer{0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00};
+    REQUIRE(uleb128<uint64_t>(std::span{over}).passed() == false);
+    REQUIRE(uleb128<uint64_t>(std::span{longer}).passed() == false);
+    REQUIRE(std::ranges::size(uleb128<uint64_t>(std::span{longer}).remaining()) == 12);
+
+    static constexpr std::array<uint8_t, 9> max32{0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0, 0, 0, 0};
+    static constexpr std::array<uint8_t, 9> over32{0xFF, 0xFF, 0xFF, 0xFF, 0x1F, 0, 0, 0, 0};
+    REQUIRE(*uleb128<uint32_t>(std::span{max32}) == UINT32_MAX);
+    REQUIRE(uleb128<uint32_t>(std::span{over32}).passed() == false);
+    REQUIRE(*uleb128<uint32_t>(std::span{max32}.first(5)) == UINT32_MAX);
+    REQUIRE(uleb128<uint32_t>(std::span{over32}.first(5)).passed() == false);
+    STATIC_REQUIRE(uleb128<uint32_t>(std::span{over32}).passed() == false);
+
+    REQUIRE(uleb128<uint64_t>(std::span{max64}.first(9)).passed() == false);
+    auto partial = uleb128<uint64_t>(streaming_input(std::span{max64}.first(9)));
+    REQUIRE(partial.incomplete() == true);
+    REQUIRE(uleb128<uint32_t>(streaming_input(std::span{longer}.first(6))).passed() == false);
+}
+
+TEST_CASE("sleb128", "[integer]") {
+    static constexpr std::array<uint8_t, 9> neg{0xC0, 0xBB, 0x78, 0, 0, 0, 0, 0, 0};
+    REQUIRE(*sleb128<int64_t>(std::span{neg}) == -123456);
+    REQUIRE(*sleb128<int32_t>(std::span{neg}.first(3)) == -123456);
+    STATIC_REQUIRE(*sleb128<int64_t>(std::span{neg}) == -123456);
+
+    static constexpr std::array<uint8_t, 9> small{0x7F, 0x3F, 0x40, 0, 0, 0, 0, 0, 0};
+    auto res = sleb128<int8_t>(std::span{small});
+    REQUIRE(*res == -1);
+    REQUIRE(*sleb128<int8_t>(res.remaining()) == 63);
+
+    static constexpr std::array<uint8_t, 10> min64{0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x7F};
+    static constexpr std::array<uint8_t, 10> bad64{0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x3F};
+    REQUIRE(*sleb128<int64_t>(std::span{min64}) == INT64_MIN);
+    REQUIRE(sleb128<int64_t>(std::span{bad64}).passed() == false);
+
+    static constexpr std::array<uint8_t, 9> min32{0x80, 0x80, 0x80, 0x80, 0x78, 0, 0, 0, 0};
+    static constexpr std::array<uint8_t, 9> bad32{0x80, 0x80, 0x80, 0x80, 0x70, 0, 0, 0, 0};
+    REQUIRE(*sleb128<int32_t>(std::span{min32}) == INT32_MIN);
+    REQUIRE(sleb128<int32_t>(std::span{bad32}).passed() == false);
+}
+
+TEST_CASE("zigzag_varint", "[integer]") {
+    static constexpr std::array<uint8_t, 9> data{0x00, 0x01, 0x02, 0x03, 0xFE, 0xFF, 0x03, 0, 0};
+    std::span<const uint8_t> in{data};
+    for (int64_t expected : {0, -1, 1, -2, 32767}) {
+        auto res = zigzag_varint<int64_t>(in);
+        REQUIRE(*res == expected);
+        in = in.last(std::ranges::size(res.remaining()));
+    }
+    static constexpr std::array<uint8_t, 10> min64{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01};
+    REQUIRE(*zigzag_varint<int64_t>(std::span{min64}) == INT64_MIN);
+    STATIC_REQUIRE(*zigzag_varint<int32_t>(std::span{data}.subspan(4)) == 32767);
+}
@@ -0,0 +1,95 @@
+#include <ctpc/alt.hpp>
+#include <ctpc/error.hpp>
+#include <ctpc/keyword.hpp>
+#include <ctpc/map.hpp>
+#include <ctpc/streaming.hpp>
+#include <ctpc/verbatim.hpp>
+#include <algorithm>
+#include <list>
+#include <string_view>
+#include "test_utils.hpp"
+
+using namespace ctpc;
+
+static constexpr auto method = one_of_literals<"GET", "HEAD", "POST", "PUT", "PATCH", "DELETE", "OPTIONS">;
+
+TEST_CASE("one_of_literals", "[keyword]") {
+    auto res = method("POST /index.html"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == "POST"sv);
+    REQUIRE(res.remaining() == " /index.html"sv);
+
+    REQUIRE(*method("PATCH"sv) == "PATCH"sv);
+    REQUIRE(*method("PUTS"sv) == "PUT"sv);
+
+    auto bad = method("PAST"sv);
+    REQUIRE(bad.passed() == false);
+    REQUIRE(bad.remaining() == "PAST"sv);
+    REQUIRE(method(""sv).passed() == false);
+    REQUIRE(method("get"sv).passed() == false);
+
+    STATIC_REQUIRE(*method("DELETE x"sv) == "DELETE"sv);
+}
+
+TEST_CASE("one_of_literals longest match", "[keyword]") {
+    static constexpr auto keyword = one_of_literals<"IN", "INSERT", "INTO", "INT">;
+    REQUIRE(*keyword("INSERT INTO"sv) == "INSERT"sv);
+    REQUIRE(*keyword("INTO t"sv) == "INTO"sv);
+    REQUIRE(*keyword("INTEGER"sv) == "INT"sv);
+    REQUIRE(*keyword("INS"sv) == "IN"sv);
+    REQUIRE(keyword("I"sv).passed() == false);
+
+    std::list<char> chars{'I', 'N', 'T', 'O', 'X'};
+    auto listed = keyword(std::ranges::subrange(chars));
+    REQUIRE(std::ranges::distance(*listed) == 4);
+
+    REQUIRE(std::ranges::size(*keyword(U"INTO"sv)) == 4);
+}
+
+TEST_CASE("keyword_map", "[keyword]") {
+    enum class Kind { kw_if, kw_else, kw_elif, kw_while };
+    static constexpr auto kind = map(
+        keyword_map<"if", "else", "elif", "while">,
+        [](size_t index) { return static_cast<Kind>(index); }
+    );
+    REQUIRE(*kind("while (x)"sv) == Kind::kw_while);
+    REQUIRE(*kind("elif"sv) == Kind::kw_elif);
+    REQUIRE(*kind("else:"sv) == Kind::kw_else);
+    REQUIRE(kind("el"sv).passed() == false);
+
+    static constexpr auto dup = keyword_map<"a", "b", "a">;
+    REQUIRE(*dup("a"sv) == 0);
+    STATIC_REQUIRE(*keyword_map<"x", "y">("y"sv) == 1);
+}
+
+TEST_CASE("one_of_literals first set", "[keyword]") {
+    static constexpr auto set = decltype(method)::first_set<char>();
+    STATIC_REQUIRE(set.has_value());
+    STATIC_REQUIRE(set->contains('G'));
+    STATIC_REQUIRE(set->contains('O'));
+    STATIC_REQUIRE(!set->contains('X'));
+    STATIC_REQUIRE(!decltype(one_of_literals<"", "a">)::first_set<char>().has_value());
+
+    static constexpr auto token = alt(method, map(verbatim<"X">, [](auto) { return "X"sv; }));
+    REQUIRE(token("OPTIONS"sv).passed() == true);
+}
+
+TEST_CASE("one_of_literals streaming", "[keyword]") {
+    REQUIRE(method(streaming_input("PU"sv)).incomplete() == true);
+    REQUIRE(*method(streaming_input("PUT"sv)) == "PUT"sv);
+    REQUIRE(method(streaming_input("PATC"sv)).incomplete() == true);
+    REQUIRE(*method(streaming_input("PUT "sv)) == "PUT"sv);
+    REQUIRE(*method(streaming_input("DELETE"sv)) == "DELETE"sv);
+    REQUIRE(method(streaming_input("X"sv)).passed() == false);
+}
+
+TEST_CASE("one_of_literals errors", "[keyword]") {
+    static constexpr auto small = one_of_literals<"on", "off">;
+    ErrorContext errors{};
+    auto res = parse_with_errors(small, "of"sv, errors);
+    REQUIRE(res.passed() == false);
+    REQUIRE(errors.offset() == 0);
+    REQUIRE(errors.expected().size() == 2);
+    REQUIRE(errors.expected()[0] == "\"on\""sv);
+    REQUIRE(errors.expected()[1] == "\"off\""sv);
+}
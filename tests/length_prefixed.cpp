@@ -0,0 +1,100 @@
+#include <ctpc/complete.hpp>
+#include <ctpc/integer.hpp>
+#include <ctpc/length_prefixed.hpp>
+#include <ctpc/number.hpp>
+#include <ctpc/seq.hpp>
+#include <ctpc/streaming.hpp>
+#include <ctpc/take.hpp>
+#include <ctpc/terminated.hpp>
+#include <ctpc/verbatim.hpp>
+#include <array>
+#include <cstdint>
+#include <list>
+#include <span>
+#include <string_view>
+#include "test_utils.hpp"
+
+using namespace ctpc;
+
+static constexpr std::array<uint8_t, 5> frame{0x03, 0x01, 0x02, 0x03, 0xAA};
+
+TEST_CASE("length_prefixed", "[length_prefixed]") {
+    auto res = length_prefixed(uint8, uint16_be)(std::span{frame});
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == 0x0102);
+    // The rest of the frame is skipped
+    REQUIRE(std::ranges::size(res.remaining()) == 1);
+    REQUIRE(*std::ranges::begin(res.remaining()) == 0xAA);
+
+    auto whole = length_prefixed(uint8, complete(uint16_be))(std::span{frame});
+    REQUIRE(whole.passed() == false);
+    REQUIRE(std::ranges::size(whole.remaining()) == 5);
+
+    auto pair = length_prefixed(uint8, complete(seq(uint16_be, uint8)))(std::span{frame});
+    REQUIRE(pair.passed() == true);
+    REQUIRE(std::get<1>(*pair) == 0x03);
+
+    STATIC_REQUIRE(*length_prefixed(uint8, uint16_be)(std::span{frame}) == 0x0102);
+}
+
+TEST_CASE("length_prefixed bounds the inner parser", "[length_prefixed]") {
+    // The frame holds one byte, so a 16 bit integer cannot be read from it
+    static constexpr std::array<uint8_t, 4> short_frame{0x01, 0x01, 0x02, 0x03};
+    auto res = length_prefixed(uint8, uint16_be)(std::span{short_frame});
+    REQUIRE(res.passed() == false);
+    REQUIRE(std::ranges::size(res.remaining()) == 4);
+
+    // More length than input
+    REQUIRE(length_prefixed(uint8, uint16_be)(std::span{frame}.first(3)).passed() == false);
+
+    static constexpr std::array<uint8_t, 3> negative{0xFF, 0x01, 0x02};
+    REQUIRE(length_prefixed(int8, uint8)(std::span{negative}).passed() == false);
+
+    static constexpr std::array<uint8_t, 2> empty{0x00, 0x01};
+    REQUIRE(length_prefixed(uint8, uint8)(std::span{empty}).passed() == false);
+    auto skipped = skip_length_prefixed(uint8)(std::span{empty});
+    REQUIRE(skipped.passed() == true);
+    REQUIRE(std::ranges::size(skipped.remaining()) == 1);
+}
+
+TEST_CASE("skip_length_prefixed", "[length_prefixed]") {
+    auto res = skip_length_prefixed(uint8)(std::span{frame});
+    REQUIRE(res.passed() == true);
+    REQUIRE(std::ranges::size(res.remaining()) == 1);
+    REQUIRE(skip_length_prefixed(uint8)(std::span{frame}.first(3)).passed() == false);
+
+    std::list<uint8_t> list(frame.begin(), frame.end());
+    auto listed = skip_length_prefixed(uint8)(std::ranges::subrange(list.begin(), list.end()));
+    REQUIRE(listed.passed() == true);
+    REQUIRE(*std::ranges::begin(listed.remaining()) == 0xAA);
+    STATIC_REQUIRE(skip_length_prefixed(uint8)(std::span{frame}).passed() == true);
+}
+
+TEST_CASE("length_prefixed text", "[length_prefixed]") {
+    // A netstring: a decimal length, a colon, and the payload
+    static constexpr auto netstring = terminated(
+        length_prefixed(terminated(dec_int<size_t>, verbatim<":">), take_while<[](char) { return true; }>),
+        verbatim<",">
+    );
+    auto res = netstring("5:he,lo,rest"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(std::string_view(std::ranges::begin(*res), std::ranges::end(*res)) == "he,lo"sv);
+    REQUIRE(res.remaining() == "rest"sv);
+    REQUIRE(netstring("9:he,lo,rest"sv).passed() == false);
+}
+
+TEST_CASE("length_prefixed streaming", "[length_prefixed]") {
+    auto partial = length_prefixed(uint8, uint16_be)(streaming_input(std::span{frame}.first(3)));
+    REQUIRE(partial.incomplete() == true);
+    REQUIRE(partial.needed() == 1);
+
+    auto no_length = length_prefixed(uint16_be, uint8)(streaming_input(std::span{frame}.first(1)));
+    REQUIRE(no_length.incomplete() == true);
+    REQUIRE(skip_length_prefixed(uint8)(streaming_input(std::span{frame}.first(2))).needed() == 2);
+
+    // A whole frame is parsed as ordinary input, even at the end of a
+    // streaming input
+    auto res = length_prefixed(uint8, take_while<[](uint8_t) { return true; }>)(streaming_input(std::span{frame}.first(4)));
+    REQUIRE(res.passed() == true);
+    REQUIRE(std::ranges::size(*res) == 3);
+}
@@ -0,0 +1,132 @@
+#include <ctpc/alt.hpp>
+#include <ctpc/lexer.hpp>
+#include <ctpc/many0.hpp>
+#include <ctpc/map.hpp>
+#include <ctpc/preceded.hpp>
+#include <ctpc/regex_match.hpp>
+#include <ctpc/utils.hpp>
+#include <vector>
+#include "test_utils.hpp"
+
+using namespace ctpc;
+
+static constexpr auto token = lexer<
+    "if|else|while",
+    "[a-zA-Z_]\\w*",
+    "\\d+(\\.\\d+)?",
+    "[-+*/=<>]=?",
+    "\"([^\"\\\\]|\\\\.)*\""
+>;
+
+TEST_CASE("lexer longest match", "[lexer]") {
+    auto res = token("iffy = 1"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->token == 1);
+    REQUIRE(res->text == "iffy"sv);
+    REQUIRE(res.remaining() == " = 1"sv);
+
+    res = token("12.5;"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->token == 2);
+    REQUIRE(res->text == "12.5"sv);
+
+    res = token("12.x"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->text == "12"sv);
+    REQUIRE(res.remaining() == ".x"sv);
+
+    res = token("<=>"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->token == 3);
+    REQUIRE(res->text == "<="sv);
+}
+
+TEST_CASE("lexer tie break", "[lexer]") {
+    auto res = token("while("sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->token == 0);
+    REQUIRE(res->text == "while"sv);
+    REQUIRE(res.remaining() == "("sv);
+
+    res = token("else"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->token == 0);
+    REQUIRE(res.remaining() == ""sv);
+}
+
+TEST_CASE("lexer escapes and classes", "[lexer]") {
+    auto res = token(R"("a\"b" x)"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->token == 4);
+    REQUIRE(res->text == R"("a\"b")"sv);
+    REQUIRE(res.remaining() == " x"sv);
+
+    res = token(R"("unterminated)"sv);
+    REQUIRE(res.passed() == false);
+}
+
+TEST_CASE("lexer failure", "[lexer]") {
+    auto res = token("; x"sv);
+    REQUIRE(res.passed() == false);
+    REQUIRE(res.remaining() == "; x"sv);
+
+    res = token(""sv);
+    REQUIRE(res.passed() == false);
+}
+
+TEST_CASE("lexer quantifiers", "[lexer]") {
+    static constexpr auto hex = lexer<"0x[0-9a-fA-F]{2,4}", "0x?">;
+    auto res = hex("0xBEEF0"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->token == 0);
+    REQUIRE(res->text == "0xBEEF"sv);
+
+    res = hex("0xB"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->token == 1);
+    REQUIRE(res->text == "0x"sv);
+
+    static constexpr auto opt = lexer<"a*", "(?:ab)+">;
+    auto empty = opt("zzz"sv);
+    REQUIRE(empty.passed() == true);
+    REQUIRE(empty->token == 0);
+    REQUIRE(empty->text == ""sv);
+
+    empty = opt("ababa"sv);
+    REQUIRE(empty->token == 1);
+    REQUIRE(empty->text == "abab"sv);
+}
+
+TEST_CASE("lexer in many0", "[lexer]") {
+    static constexpr auto tokens = many0(
+        preceded(regex_match<"\\s*">, token),
+        [](std::vector<size_t> acc, auto lexeme) {
+            acc.push_back(lexeme.token);
+            return acc;
+        },
+        [] { return std::vector<size_t>{}; }
+    );
+    auto res = tokens("if x1 = 3.5 + y while"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == std::vector<size_t>{0, 1, 3, 2, 3, 1, 0});
+    REQUIRE(res.remaining() == ""sv);
+}
+
+TEST_CASE("lexer first set", "[lexer]") {
+    static constexpr auto set = *decltype(token)::first_set<char>();
+    STATIC_REQUIRE(set.contains('i'));
+    STATIC_REQUIRE(set.contains('7'));
+    STATIC_REQUIRE(set.contains('"'));
+    STATIC_REQUIRE(!set.contains(' '));
+    STATIC_REQUIRE(!set.contains(';'));
+    STATIC_REQUIRE(!decltype(lexer<"a*">)::first_set<char>().has_value());
+
+    static constexpr auto word = alt(map(token, [](auto lexeme) { return lexeme.text; }), regex_match<";">);
+    REQUIRE(word(";"sv).passed() == true);
+    REQUIRE(word("x;"sv).passed() == true);
+}
+
+TEST_CASE("lexer constant evaluation", "[lexer]") {
+    STATIC_REQUIRE(token("while1 "sv)->token == 1);
+    STATIC_REQUIRE(token("42"sv).remaining().empty());
+}
@@ -0,0 +1,214 @@
+#include <ctpc/count.hpp>
+#include <ctpc/many0.hpp>
+#include <ctpc/many1.hpp>
+#include <ctpc/regex_match.hpp>
+#include <ctpc/streaming.hpp>
+#include <ctpc/utils.hpp>
+#include <ctpc/verbatim.hpp>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "test_utils.hpp"
+
+using namespace ctpc;
+
+namespace {
+
+// Counts how often it is copied or moved.
+struct Tracked {
+    static inline size_t moves = 0;
+    static inline size_t copies = 0;
+
+    Tracked() = default;
+    Tracked(const Tracked&) { ++copies; }
+    Tracked(Tracked&&) noexcept { ++moves; }
+    Tracked& operator=(const Tracked&) { ++copies; return *this; }
+    Tracked& operator=(Tracked&&) noexcept { ++moves; return *this; }
+};
+
+struct AppendInPlace {
+    void operator()(utils::ReduceInPlace, std::string& accum, std::string_view item) const {
+        accum += item;
+    }
+};
+
+struct AppendByValue {
+    std::string operator()(std::string accum, std::string_view item) const {
+        return accum + std::string(item);
+    }
+};
+
+}
+
+TEST_CASE("in place reduce detection", "[many]") {
+    STATIC_REQUIRE(utils::InPlaceReduce<const utils::DefaultReduce&, std::vector<int>, int>);
+    STATIC_REQUIRE(utils::InPlaceReduce<const AppendInPlace&, std::string, std::string_view>);
+    STATIC_REQUIRE(!utils::InPlaceReduce<const AppendByValue&, std::string, std::string_view>);
+    STATIC_REQUIRE(!utils::InPlaceReduce<const AppendInPlace&, std::vector<int>, int>);
+}
+
+TEST_CASE("default reduce reserves for short lists", "[many]") {
+    static constexpr auto abs = many0(verbatim<"ab">, utils::default_reduce, utils::default_reduce_init);
+    auto res = abs("ababab"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->size() == 3);
+    REQUIRE(res->capacity() == utils::DefaultReduce::initial_capacity<std::string_view>);
+
+    auto none = abs("x"sv);
+    REQUIRE(none.passed() == true);
+    REQUIRE(none->capacity() == 0);
+}
+
+TEST_CASE("default reduce scales its first reservation", "[many]") {
+    STATIC_REQUIRE(utils::DefaultReduce::initial_capacity<char> == 8);
+    STATIC_REQUIRE(utils::DefaultReduce::initial_capacity<std::array<char, 64>> == 4);
+    STATIC_REQUIRE(utils::DefaultReduce::initial_capacity<std::array<char, 4096>> == 1);
+
+    std::vector<int> hinted{};
+    hinted.reserve(2);
+    utils::reduce_into(utils::default_reduce, hinted, 1);
+    REQUIRE(hinted.capacity() == 2);
+}
+
+TEST_CASE("default reduce by value", "[many]") {
+    std::vector<int> accum{};
+    accum = utils::default_reduce(accum, 1);
+    accum = utils::default_reduce(std::move(accum), 2);
+    REQUIRE(accum == std::vector<int>{1, 2});
+
+    STATIC_REQUIRE(std::same_as<decltype(utils::default_reduce(accum, 3)), std::vector<int>>);
+}
+
+TEST_CASE("default reduce does not move the accumulator", "[many]") {
+    static constexpr auto item = [](auto input) {
+        auto begin = std::ranges::begin(input);
+        auto end = std::ranges::end(input);
+        if (begin == end) {
+            return fail<Tracked>(input);
+        }
+        return pass<Tracked>(std::ranges::subrange(std::ranges::next(begin), end), Tracked{});
+    };
+    std::vector<Tracked> accum{};
+    accum.reserve(16);
+    Tracked::moves = 0;
+    Tracked::copies = 0;
+    for (size_t i = 0; i < 10; ++i) {
+        utils::reduce_into(utils::default_reduce, accum, Tracked{});
+    }
+    REQUIRE(Tracked::moves == 10);
+    REQUIRE(Tracked::copies == 0);
+
+    auto res = many0(item, utils::default_reduce, utils::default_reduce_init)("abc"sv);
+    REQUIRE(res->size() == 3);
+    REQUIRE(Tracked::copies == 0);
+}
+
+TEST_CASE("custom reducers", "[many]") {
+    static constexpr auto in_place = many0(verbatim<"ab">, AppendInPlace{}, [] { return std::string{}; });
+    static constexpr auto by_value = many0(verbatim<"ab">, AppendByValue{}, [] { return std::string{}; });
+    REQUIRE(*in_place("ababx"sv) == "abab");
+    REQUIRE(*by_value("ababx"sv) == "abab");
+
+    static constexpr auto counted = count(verbatim<"ab">, 2, AppendInPlace{}, [] { return std::string{}; });
+    REQUIRE(*counted("ababab"sv) == "abab");
+}
+
+TEST_CASE("many1", "[many]") {
+    static constexpr auto abs = many1(verbatim<"ab">, utils::default_reduce, utils::default_reduce_init);
+    auto res = abs("ababx"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->size() == 2);
+    REQUIRE(res.remaining() == "x"sv);
+
+    auto bad = abs("x"sv);
+    REQUIRE(bad.passed() == false);
+    REQUIRE(bad.remaining() == "x"sv);
+
+    static constexpr auto total = many1(verbatim<"ab">, [](size_t n, auto) { return n + 1; }, size_t{0});
+    STATIC_REQUIRE(*total("ababab"sv) == 3);
+    STATIC_REQUIRE(!total(""sv).passed());
+}
+
+TEST_CASE("many1 streaming", "[many]") {
+    static constexpr auto abs = many1(verbatim<"ab">, utils::default_reduce, utils::default_reduce_init);
+    auto partial = abs(streaming_input("aba"sv));
+    REQUIRE(partial.incomplete() == true);
+    REQUIRE(partial.needed() == 1);
+
+    auto first = abs(streaming_input("a"sv));
+    REQUIRE(first.incomplete() == true);
+}
+
+TEST_CASE("many constant evaluation", "[many]") {
+    STATIC_REQUIRE(many0(verbatim<"ab">, utils::default_reduce, utils::default_reduce_init)("abab"sv)->size() == 2);
+    STATIC_REQUIRE(many1(verbatim<"ab">, utils::default_reduce, utils::default_reduce_init)("abab"sv)->size() == 2);
+}
+
+TEST_CASE("count_of", "[many]") {
+    REQUIRE(utils::count_of(',')("1,2,,3"sv) == 3);
+    REQUIRE(utils::count_of(',')(""sv) == 0);
+    STATIC_REQUIRE(utils::count_of(',')(",a,"sv) == 2);
+    REQUIRE(utils::count_of(2)(std::vector<int>{1, 2, 3, 2}) == 2);
+
+    // Values that no element can equal are not truncated to a byte
+    REQUIRE(utils::count_of(300)("1,2,,3"sv) == 0);
+    REQUIRE(utils::count_of(44)("1,2,,3"sv) == 3);
+    static constexpr std::array<uint8_t, 2> bytes{0xFF, 0xFF};
+    REQUIRE(utils::count_of(-1)(std::span{bytes}) == 0);
+    REQUIRE(utils::count_of(255)(std::span{bytes}) == 2);
+}
+
+TEST_CASE("many0_sized", "[many]") {
+    static constexpr auto lines = many0_sized(
+        regex_match<"[a-z]*\n">,
+        utils::count_of('\n')
+    );
+    auto input = std::string(20, 'x');
+    for (size_t i = 0; i < 20; ++i) {
+        input[i] = i % 2 == 0 ? 'a' : '\n';
+    }
+    auto res = lines(std::string_view{input});
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->size() == 10);
+    REQUIRE(res->capacity() == 10);
+
+    // The hint is passed to an init taking a size
+    static constexpr auto sized_init = many0_sized(
+        verbatim<"ab">,
+        [](auto) { return size_t{3}; },
+        [](size_t n, auto) { return n + 1; },
+        [](size_t hint) { return hint * 100; }
+    );
+    REQUIRE(*sized_init("abab"sv) == 302);
+
+    // Hints are capped at the input size
+    static constexpr auto huge = many0_sized(
+        verbatim<"ab">,
+        [](auto) { return size_t{1} << 40; }
+    );
+    REQUIRE(huge("abab"sv)->capacity() == 4);
+}
+
+TEST_CASE("many1_sized", "[many]") {
+    static constexpr auto items = many1_sized(
+        regex_match<"[0-9]+,">,
+        utils::count_of(',')
+    );
+    auto res = items("1,22,333,"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->size() == 3);
+    REQUIRE(res->capacity() == 3);
+    REQUIRE(items("x"sv).passed() == false);
+
+    // The default reduce and init may be given explicitly
+    static constexpr auto explicit_defaults = many1_sized(
+        verbatim<"a,">,
+        utils::count_of(','),
+        utils::default_reduce,
+        utils::default_reduce_init
+    );
+    REQUIRE(explicit_defaults("a,a,"sv)->size() == 2);
+}
@@ -0,0 +1,90 @@
+#include <ctpc/memo.hpp>
+#include <ctpc/alt.hpp>
+#include <ctpc/ignore.hpp>
+#include <ctpc/map.hpp>
+#include <ctpc/seq.hpp>
+#include <ctpc/verbatim.hpp>
+#include "test_utils.hpp"
+
+using namespace ctpc;
+
+static size_t calls = 0;
+
+static constexpr auto counted = memo([](Input auto input) {
+    ++calls;
+    return verbatim<"ab">(input);
+});
+
+static constexpr auto shared_prefix = alt(
+    ignore(seq(counted, verbatim<"c">)),
+    ignore(seq(counted, verbatim<"d">)),
+    ignore(counted)
+);
+
+template <Input I>
+constexpr ParseResultOf<size_t, I> left_(I input);
+static constexpr auto left = memo(CTPC_F(left_));
+
+template <Input I>
+constexpr ParseResultOf<size_t, I> left_(I input) {
+    return alt(
+        map(seq(left, verbatim<"a">), [](auto count, auto) { return count + 1; }),
+        map(verbatim<"a">, [](auto) { return size_t{1}; })
+    )(input);
+}
+
+constexpr size_t count_left(std::string_view input) {
+    MemoTable table;
+    return *left(memo_input(input, table));
+}
+
+TEST_CASE("memo without table", "[memo]") {
+    calls = 0;
+    auto res = shared_prefix("abd"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res.remaining() == ""sv);
+    REQUIRE(calls == 2);
+}
+
+TEST_CASE("memo evaluates once per position", "[memo]") {
+    calls = 0;
+    MemoTable table;
+    auto res = shared_prefix(memo_input("abd"sv, table));
+    REQUIRE(res.passed() == true);
+    REQUIRE(res.remaining().empty());
+    REQUIRE(calls == 1);
+    REQUIRE(table.size() == 1);
+}
+
+TEST_CASE("memo caches failures", "[memo]") {
+    calls = 0;
+    MemoTable table;
+    auto res = shared_prefix(memo_input("xyz"sv, table));
+    REQUIRE(res.passed() == false);
+    REQUIRE(std::ranges::begin(res.remaining()).position() == 0);
+    REQUIRE(calls == 1);
+}
+
+TEST_CASE("memo table reuse", "[memo]") {
+    MemoTable table;
+    for (auto input : {"abc"sv, "abd"sv, "ab"sv}) {
+        calls = 0;
+        table.clear();
+        auto res = shared_prefix(memo_input(input, table));
+        REQUIRE(res.passed() == true);
+        REQUIRE(res.remaining().empty());
+        REQUIRE(calls == 1);
+    }
+}
+
+TEST_CASE("memo left recursion", "[memo]") {
+    MemoTable table;
+    auto res = left(memo_input("aaa"sv, table));
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == 1);
+    REQUIRE(std::ranges::begin(res.remaining()).position() == 1);
+}
+
+TEST_CASE("memo constexpr", "[memo]") {
+    STATIC_REQUIRE(count_left("aaa"sv) == 1);
+}
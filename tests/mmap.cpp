@@ -0,0 +1,99 @@
+#include <ctpc/mmap.hpp>
+#include <ctpc/integer.hpp>
+#include <ctpc/verbatim.hpp>
+#include "test_utils.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace ctpc;
+
+namespace {
+
+struct TempFile {
+    std::filesystem::path path;
+
+    TempFile(std::string_view name, std::string_view contents)
+        : path(std::filesystem::temp_directory_path() / name) {
+        std::ofstream out(path, std::ios::binary);
+        out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    }
+
+    ~TempFile() {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+};
+
+}
+
+TEST_CASE("text view", "[mmap]") {
+    TempFile tmp("ctpc_mmap_text", "hello world");
+    auto file = mmap_input(tmp.path);
+    REQUIRE(file.size() == 11);
+    auto res = verbatim<"hello">(file.text());
+    REQUIRE(res.passed() == true);
+    REQUIRE(res.remaining() == " world"sv);
+}
+
+TEST_CASE("byte view", "[mmap]") {
+    TempFile tmp("ctpc_mmap_bytes", "\x01\x02\x03\x04");
+    auto file = mmap_input(tmp.path);
+    auto res = uint32_be(file.bytes());
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == 0x01020304);
+}
+
+TEST_CASE("empty file", "[mmap]") {
+    TempFile tmp("ctpc_mmap_empty", "");
+    auto file = mmap_input(tmp.path);
+    REQUIRE(file.empty() == true);
+    REQUIRE(file.text().empty() == true);
+}
+
+TEST_CASE("missing file", "[mmap]") {
+    REQUIRE_THROWS_AS(mmap_input("/nonexistent/ctpc_mmap"), std::system_error);
+}
+
+TEST_CASE("parse each", "[mmap]") {
+    std::string contents{};
+    for (size_t i = 0; i < 1000; ++i) {
+        contents += "ab";
+    }
+    contents += "x";
+    TempFile tmp("ctpc_mmap_each", contents);
+    auto file = mmap_input(tmp.path);
+
+    size_t values = 0;
+    size_t reports = 0;
+    auto progress = parse_each(
+        file,
+        verbatim<"ab">,
+        [&](auto value) {
+            REQUIRE(value == "ab"sv);
+            ++values;
+        },
+        [&](const ParseProgress&) { ++reports; },
+        100
+    );
+    REQUIRE(values == 1000);
+    REQUIRE(progress.count == 1000);
+    REQUIRE(progress.consumed == 2000);
+    REQUIRE(progress.total == 2001);
+    REQUIRE(progress.done() == false);
+    REQUIRE(reports == 21);
+}
+
+TEST_CASE("parse each bytes", "[mmap]") {
+    TempFile tmp("ctpc_mmap_each_bytes", std::string_view("\x00\x01\x00\x02\x00\x03", 6));
+    auto file = mmap_input(tmp.path);
+    std::vector<uint16_t> values{};
+    auto progress = parse_each<std::byte>(file, uint16_be, [&](uint16_t value) { values.push_back(value); });
+    REQUIRE(progress.done() == true);
+    REQUIRE(values == std::vector<uint16_t>{1, 2, 3});
+}
@@ -0,0 +1,204 @@
+#include <ctpc/number.hpp>
+#include <ctll/fixed_string.hpp>
+#include <ctpc/streaming.hpp>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <string>
+#include <string_view>
+#include "test_utils.hpp"
+
+using namespace ctpc;
+
+TEST_CASE("dec_int", "[number]") {
+    auto res = dec_int<uint32_t>("12345,"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == 12345);
+    REQUIRE(res.remaining() == ","sv);
+
+    REQUIRE(*dec_int<uint64_t>("0"sv) == 0);
+    REQUIRE(*dec_int<uint64_t>("007"sv) == 7);
+    REQUIRE(*dec_int<uint64_t>("1234567890123"sv) == 1234567890123u);
+    REQUIRE(*dec_int<uint64_t>("12345678x"sv) == 12345678);
+    REQUIRE(*dec_int<uint64_t>("123456789 "sv) == 123456789);
+
+    auto none = dec_int<int>("x1"sv);
+    REQUIRE(none.passed() == false);
+    REQUIRE(none.remaining() == "x1"sv);
+    REQUIRE(dec_int<unsigned>("-1"sv).passed() == false);
+
+    STATIC_REQUIRE(*dec_int<int>("-42"sv) == -42);
+    STATIC_REQUIRE(*dec_int<uint64_t>("18446744073709551615"sv) == std::numeric_limits<uint64_t>::max());
+}
+
+TEST_CASE("dec_int signed", "[number]") {
+    REQUIRE(*dec_int<int64_t>("-9223372036854775808"sv) == std::numeric_limits<int64_t>::min());
+    REQUIRE(*dec_int<int64_t>("9223372036854775807"sv) == std::numeric_limits<int64_t>::max());
+    REQUIRE(dec_int<int64_t>("9223372036854775808"sv).passed() == false);
+    REQUIRE(*dec_int<int8_t>("-128"sv) == -128);
+    REQUIRE(dec_int<int8_t>("128"sv).passed() == false);
+    REQUIRE(dec_int<int>("-"sv).passed() == false);
+    REQUIRE(dec_int<int>("-x"sv).passed() == false);
+}
+
+TEST_CASE("dec_int overflow", "[number]") {
+    auto res = dec_int<uint64_t>("18446744073709551616"sv);
+    REQUIRE(res.passed() == false);
+    REQUIRE(res.remaining() == "18446744073709551616"sv);
+    REQUIRE(dec_int<uint64_t>("99999999999999999999999"sv).passed() == false);
+    REQUIRE(*dec_int<uint16_t>("65535"sv) == 65535);
+    REQUIRE(dec_int<uint16_t>("65536"sv).passed() == false);
+    REQUIRE(dec_int<uint8_t>("25612345678"sv).passed() == false);
+    REQUIRE(*dec_int<uint64_t>("00000000000000000000000000001"sv) == 1);
+}
+
+TEST_CASE("dec_int matches scalar conversion", "[number]") {
+    std::string text{};
+    uint64_t expected = 0;
+    for (size_t i = 0; i < 19; ++i) {
+        text += static_cast<char>('0' + (i * 7 + 3) % 10);
+        expected = expected * 10 + (i * 7 + 3) % 10;
+        for (auto suffix : {""sv, " "sv, "abcdefghijk"sv}) {
+            auto input = text + std::string(suffix);
+            auto res = dec_int<uint64_t>(std::string_view{input});
+            REQUIRE(res.passed() == true);
+            REQUIRE(*res == expected);
+            REQUIRE(std::ranges::size(res.remaining()) == suffix.size());
+        }
+    }
+
+    std::list<char> chars{'9', '8', '7', '.'};
+    REQUIRE(*dec_int<int>(std::ranges::subrange(chars)) == 987);
+    REQUIRE(*dec_int<int>(U"-31"sv) == -31);
+}
+
+TEST_CASE("hex_int", "[number]") {
+    REQUIRE(*hex_int<uint32_t>("ff"sv) == 0xff);
+    REQUIRE(*hex_int<uint32_t>("DeadBeef;"sv) == 0xdeadbeef);
+    REQUIRE(*hex_int<uint64_t>("0123456789abcdefg"sv) == 0x0123456789abcdef);
+    REQUIRE(*hex_int<uint64_t>("FFFFFFFFFFFFFFFF"sv) == std::numeric_limits<uint64_t>::max());
+    REQUIRE(hex_int<uint64_t>("10000000000000000"sv).passed() == false);
+    REQUIRE(hex_int<uint32_t>("100000000"sv).passed() == false);
+    REQUIRE(*hex_int<int>("-1a"sv) == -26);
+    REQUIRE(*hex_int<uint32_t>("abcdefgh"sv) == 0xabcdef);
+    REQUIRE(*hex_int<uint32_t>("12345@G`"sv) == 0x12345);
+    REQUIRE(hex_int<uint32_t>("g"sv).passed() == false);
+
+    // Characters that only look like hex digits once case is folded
+    REQUIRE(*hex_int<uint64_t>("1\x10\x41\x61\x46\x66\x47"sv) == 1);
+    REQUIRE(*hex_int<uint64_t>("aF09Af90"sv) == 0xaf09af90);
+
+    STATIC_REQUIRE(*hex_int<uint32_t>("C0fFee"sv) == 0xc0ffee);
+}
+
+TEST_CASE("text integer streaming", "[number]") {
+    REQUIRE(dec_int<int>(streaming_input("123"sv)).incomplete() == true);
+    REQUIRE(dec_int<int>(streaming_input("-"sv)).incomplete() == true);
+    REQUIRE(*dec_int<int>(streaming_input("123;"sv)) == 123);
+    REQUIRE(*dec_int<int>(streaming_input("1234567890;"sv)) == 1234567890);
+    REQUIRE(hex_int<int>(streaming_input("abc"sv)).incomplete() == true);
+}
+
+TEST_CASE("float_", "[number]") {
+    auto res = float_<double>("3.25,"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == 3.25);
+    REQUIRE(res.remaining() == ","sv);
+
+    REQUIRE(*float_<double>("-0.5e-3"sv) == -0.5e-3);
+    REQUIRE(*float_<double>(".5"sv) == 0.5);
+    REQUIRE(*float_<double>("7."sv) == 7.0);
+    REQUIRE(*float_<double>("1E+10"sv) == 1e10);
+    REQUIRE(*float_<float>("0.1"sv) == 0.1f);
+    REQUIRE(std::signbit(*float_<double>("-0"sv)));
+
+    auto exp = float_<double>("2e"sv);
+    REQUIRE(*exp == 2.0);
+    REQUIRE(exp.remaining() == "e"sv);
+    REQUIRE(float_<double>("2e+x"sv).remaining() == "e+x"sv);
+
+    for (auto bad : {""sv, "."sv, "-"sv, "+1"sv, " 1"sv, "e5"sv, "-.e1"sv}) {
+        auto fail = float_<double>(bad);
+        REQUIRE(fail.passed() == false);
+        REQUIRE(fail.remaining() == bad);
+    }
+}
+
+TEST_CASE("float_ special values and range", "[number]") {
+    REQUIRE(std::isinf(*float_<double>("inf"sv)));
+    REQUIRE(*float_<double>("-Infinity"sv) == -std::numeric_limits<double>::infinity());
+    REQUIRE(float_<double>("infinit"sv).remaining() == "init"sv);
+    REQUIRE(std::isnan(*float_<double>("NaN"sv)));
+    REQUIRE(std::ranges::empty(float_<double>("nan(0x1f)"sv).remaining()));
+    REQUIRE(float_<double>("nan(x"sv).remaining() == "(x"sv);
+
+    REQUIRE(float_<double>("1e309"sv).passed() == false);
+    REQUIRE(float_<double>("1e-400"sv).passed() == false);
+    REQUIRE(*float_<double>("4e-324"sv) == std::numeric_limits<double>::denorm_min());
+    REQUIRE(float_<float>("1e39"sv).passed() == false);
+    REQUIRE(*float_<double>("0e999999999"sv) == 0.0);
+}
+
+// Compile-time conversions must agree exactly with `std::from_chars`
+template <ctll::fixed_string TEXT>
+static void check_constexpr_float() {
+    static constexpr auto text = [] {
+        std::array<char, TEXT.size()> ret{};
+        for (size_t i = 0; i < TEXT.size(); ++i) {
+            ret[i] = static_cast<char>(TEXT[i]);
+        }
+        return ret;
+    }();
+    static constexpr std::string_view input{text.data(), text.size()};
+    static constexpr auto compile_time = float_<double>(input);
+    static constexpr auto compile_time_f = float_<float>(input);
+    auto runtime = float_<double>(input);
+    auto runtime_f = float_<float>(input);
+    REQUIRE(compile_time.passed() == runtime.passed());
+    REQUIRE(compile_time_f.passed() == runtime_f.passed());
+    if (runtime) {
+        REQUIRE(std::bit_cast<uint64_t>(*compile_time) == std::bit_cast<uint64_t>(*runtime));
+    }
+    if (runtime_f) {
+        REQUIRE(std::bit_cast<uint32_t>(*compile_time_f) == std::bit_cast<uint32_t>(*runtime_f));
+    }
+}
+
+TEST_CASE("float_ constant evaluation", "[number]") {
+    check_constexpr_float<"0">();
+    check_constexpr_float<"1">();
+    check_constexpr_float<"0.1">();
+    check_constexpr_float<"3.14159265358979323846264338327950288">();
+    check_constexpr_float<"1.7976931348623157e308">();
+    check_constexpr_float<"1.7976931348623158e308">();
+    check_constexpr_float<"1.7976931348623159e308">();
+    check_constexpr_float<"2.2250738585072014e-308">();
+    check_constexpr_float<"2.2250738585072011e-308">();
+    check_constexpr_float<"4.9406564584124654e-324">();
+    check_constexpr_float<"2.4703282292062328e-324">();
+    check_constexpr_float<"2.4703282292062327e-324">();
+    check_constexpr_float<"9007199254740993">();
+    check_constexpr_float<"9007199254740995">();
+    check_constexpr_float<"123456789012345678901234567890e-20">();
+    check_constexpr_float<"0.000000000000000000000000000000000000000000001401298464">();
+    check_constexpr_float<"3.4028235677973366e38">();
+    check_constexpr_float<"16777217">();
+    check_constexpr_float<"1e23">();
+    check_constexpr_float<"8.98846567431158e307">();
+    STATIC_REQUIRE(*float_<double>("-12.5e-1"sv) == -1.25);
+}
+
+TEST_CASE("float_ wide and streaming inputs", "[number]") {
+    REQUIRE(*float_<double>(U"6.02214076e23 mol"sv) == 6.02214076e23);
+    std::list<char> chars{'1', '.', '5', 'x'};
+    REQUIRE(*float_<double>(std::ranges::subrange(chars)) == 1.5);
+
+    REQUIRE(float_<double>(streaming_input("1.5"sv)).incomplete() == true);
+    REQUIRE(float_<double>(streaming_input("1.5e"sv)).incomplete() == true);
+    REQUIRE(float_<double>(streaming_input("in"sv)).incomplete() == true);
+    REQUIRE(*float_<double>(streaming_input("1.5e3 "sv)) == 1500.0);
+    REQUIRE(*float_<double>(streaming_input("1.5ex"sv)) == 1.5);
+}
@@ -0,0 +1,106 @@
+#include <ctpc/parallel_many.hpp>
+#include <ctpc/integer.hpp>
+#include "test_utils.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace ctpc;
+
+// Parses a decimal number followed by a newline
+static constexpr auto line = [](Input auto input) {
+    auto it = std::ranges::begin(input);
+    auto end = std::ranges::end(input);
+    uint64_t value = 0;
+    size_t digits = 0;
+    for (; it != end && *it >= '0' && *it <= '9'; ++it, ++digits) {
+        value = value * 10 + static_cast<uint64_t>(*it - '0');
+    }
+    if (digits == 0 || it == end || *it != '\n') {
+        return fail<uint64_t>(input);
+    }
+    ++it;
+    return pass<uint64_t>(std::ranges::subrange(it, end), value);
+};
+
+static std::string make_lines(size_t count) {
+    std::string ret{};
+    for (size_t i = 0; i < count; ++i) {
+        ret += std::to_string(i);
+        ret += '\n';
+    }
+    return ret;
+}
+
+TEST_CASE("small input", "[parallel_many]") {
+    auto res = parallel_many(line, split_on('\n'))("1\n22\n333\n"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == std::vector<uint64_t>{1, 22, 333});
+    REQUIRE(res.remaining().empty());
+}
+
+TEST_CASE("split_on converts the delimiter", "[parallel_many]") {
+    std::string_view text{"ab\ncd\n"};
+    std::span<const char> input{text};
+    REQUIRE(split_on('\n')(input, 0) == 3);
+    REQUIRE(split_on(10)(input, 4) == 6);
+    // 266 is not a `char`, so it must not be found as its low byte, '\n'
+    REQUIRE(split_on(266)(input, 0) == input.size());
+}
+
+TEST_CASE("large input keeps order", "[parallel_many]") {
+    auto input = make_lines(200000);
+    auto res = parallel_many(line, split_on('\n'))(std::string_view{input});
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->size() == 200000);
+    bool in_order = true;
+    for (size_t i = 0; i < res->size(); ++i) {
+        in_order = in_order && (*res)[i] == i;
+    }
+    REQUIRE(in_order);
+    REQUIRE(res.remaining().empty());
+}
+
+TEST_CASE("stops at first failure", "[parallel_many]") {
+    auto input = make_lines(200000);
+    auto bad = input.find("\n100000\n") + 1;
+    input[bad] = 'x';
+    auto res = parallel_many(line, split_on('\n'))(std::string_view{input});
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->size() == 100000);
+    REQUIRE(std::ranges::data(res.remaining()) == input.data() + bad);
+}
+
+TEST_CASE("custom reduce", "[parallel_many]") {
+    auto input = make_lines(100000);
+    auto sum = parallel_many(line, split_on('\n'), [](uint64_t accum, uint64_t value) { return accum + value; }, uint64_t{0});
+    REQUIRE(*sum(std::string_view{input}) == uint64_t{99999} * 100000 / 2);
+}
+
+TEST_CASE("length prefixed", "[parallel_many]") {
+    std::vector<uint8_t> input{};
+    for (size_t i = 0; i < 50000; ++i) {
+        input.insert(input.end(), {0, 0, 0, 4, 0, 0, static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i)});
+    }
+    auto res = parallel_many(
+        [](Input auto in) {
+            auto len = uint32_be(in);
+            if (!len || *len != 4) {
+                return fail<uint32_t>(in);
+            }
+            return uint32_be(len.remaining());
+        },
+        split_length_prefixed(uint32_be)
+    )(std::span<const uint8_t>{input});
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->size() == 50000);
+    REQUIRE((*res)[12345] == 12345);
+}
+
+TEST_CASE("constexpr", "[parallel_many]") {
+    STATIC_REQUIRE(parallel_many(line, split_on('\n'))("4\n5\n"sv)->size() == 2);
+}
@@ -0,0 +1,136 @@
+#include <ctpc/record.hpp>
+#include <ctpc/streaming.hpp>
+#include "test_utils.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <list>
+#include <span>
+
+using namespace ctpc;
+
+enum class Kind : uint16_t {
+    data = 0x0102,
+};
+
+struct Header {
+    uint32_t magic;
+    uint16_t version;
+    Kind kind;
+    double scale;
+};
+
+static constexpr auto header = record<
+    Header,
+    field_be<&Header::magic>,
+    field_le<&Header::version>,
+    field_be<&Header::kind>,
+    field_be<&Header::scale>
+>;
+
+static constexpr std::array<uint8_t, 17> header_bytes{
+    0x7F, 0x45, 0x4C, 0x46,
+    0x02, 0x00,
+    0x01, 0x02,
+    0x3F, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xAA,
+};
+
+struct Native {
+    uint32_t a;
+    uint16_t b;
+    uint16_t c;
+};
+
+struct Padded {
+    uint8_t a;
+    uint32_t b;
+};
+
+struct Swapped {
+    uint16_t first;
+    uint16_t second;
+};
+
+static constexpr auto native = record<Native, Field<&Native::a>, Field<&Native::b>, Field<&Native::c>>;
+static constexpr auto padded = record<Padded, Field<&Padded::a>, Field<&Padded::b>>;
+// The fields are read in the opposite order to their declaration
+static constexpr auto swapped = record<Swapped, field_le<&Swapped::second>, field_le<&Swapped::first>>;
+
+TEST_CASE("mixed byte order", "[record]") {
+    STATIC_REQUIRE(decltype(header)::size == 16);
+    auto res = header(std::span{header_bytes});
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->magic == 0x7F454C46);
+    REQUIRE(res->version == 2);
+    REQUIRE(res->kind == Kind::data);
+    REQUIRE(res->scale == 1.5);
+    REQUIRE(std::ranges::size(res.remaining()) == 1);
+    REQUIRE(*std::ranges::begin(res.remaining()) == 0xAA);
+}
+
+TEST_CASE("native layout", "[record]") {
+    STATIC_REQUIRE(decltype(native)::native_layout == true);
+    STATIC_REQUIRE(decltype(padded)::native_layout == false);
+    STATIC_REQUIRE(decltype(swapped)::native_layout == false);
+    STATIC_REQUIRE(decltype(header)::native_layout == false);
+
+    auto bytes = std::bit_cast<std::array<uint8_t, 8>>(Native{0x01020304, 0x0506, 0x0708});
+    auto res = native(std::span{bytes});
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->a == 0x01020304);
+    REQUIRE(res->b == 0x0506);
+    REQUIRE(res->c == 0x0708);
+    REQUIRE(std::ranges::empty(res.remaining()));
+
+    // Padding is not part of the input
+    STATIC_REQUIRE(decltype(padded)::size == 5);
+    auto value = std::bit_cast<std::array<uint8_t, 4>>(uint32_t{0x11223344});
+    std::array<uint8_t, 5> padded_bytes{0x09, value[0], value[1], value[2], value[3]};
+    auto unpadded = padded(std::span{padded_bytes});
+    REQUIRE(unpadded->a == 0x09);
+    REQUIRE(unpadded->b == 0x11223344);
+
+    static constexpr std::array<uint8_t, 4> pair{0x01, 0x00, 0x02, 0x00};
+    auto reordered = swapped(std::span{pair});
+    REQUIRE(reordered->second == 1);
+    REQUIRE(reordered->first == 2);
+}
+
+TEST_CASE("non-contiguous input", "[record]") {
+    std::list<uint8_t> list(header_bytes.begin(), header_bytes.end());
+    auto res = header(std::ranges::subrange(list.begin(), list.end()));
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->magic == 0x7F454C46);
+    REQUIRE(res->kind == Kind::data);
+    REQUIRE(res->scale == 1.5);
+    REQUIRE(*std::ranges::begin(res.remaining()) == 0xAA);
+
+    std::list<uint8_t> short_list(header_bytes.begin(), header_bytes.begin() + 10);
+    REQUIRE(header(std::ranges::subrange(short_list.begin(), short_list.end())).passed() == false);
+}
+
+TEST_CASE("insufficient input", "[record]") {
+    auto res = header(std::span{header_bytes}.first(10));
+    REQUIRE(res.passed() == false);
+    REQUIRE(res.incomplete() == false);
+    REQUIRE(std::ranges::size(res.remaining()) == 10);
+
+    auto partial = header(streaming_input(std::span{header_bytes}.first(10)));
+    REQUIRE(partial.incomplete() == true);
+    REQUIRE(partial.needed() == 6);
+
+    std::list<uint8_t> list(header_bytes.begin(), header_bytes.begin() + 10);
+    auto list_partial = header(streaming_input(std::ranges::subrange(list.begin(), list.end())));
+    REQUIRE(list_partial.incomplete() == true);
+    REQUIRE(list_partial.needed() == 6);
+}
+
+TEST_CASE("constexpr", "[record]") {
+    STATIC_REQUIRE(header(std::span{header_bytes})->magic == 0x7F454C46);
+    STATIC_REQUIRE(header(std::span{header_bytes})->version == 2);
+    STATIC_REQUIRE(header(std::span{header_bytes})->scale == 1.5);
+    STATIC_REQUIRE(header(std::span{header_bytes}.first(10)).passed() == false);
+    STATIC_REQUIRE(swapped(std::span{header_bytes})->first == 0x464C);
+}
@@ -0,0 +1,99 @@
+#include <ctpc/integer.hpp>
+#include <ctpc/regex_match.hpp>
+#include <ctpc/separated_list.hpp>
+#include <ctpc/streaming.hpp>
+#include <ctpc/utils.hpp>
+#include <ctpc/verbatim.hpp>
+#include <string_view>
+#include <vector>
+#include "test_utils.hpp"
+
+using namespace ctpc;
+
+static constexpr auto number = regex_match<"[0-9]+">;
+static constexpr auto list0 = separated_list0(number, verbatim<",">);
+static constexpr auto list1 = separated_list1(number, verbatim<",">);
+
+TEST_CASE("separated_list0", "[separated_list]") {
+    auto res = list0("1,22,333;"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->size() == 3);
+    REQUIRE((*res)[1] == "22"sv);
+    REQUIRE(res.remaining() == ";"sv);
+
+    auto one = list0("7"sv);
+    REQUIRE(one.passed() == true);
+    REQUIRE(one->size() == 1);
+
+    auto empty = list0(";"sv);
+    REQUIRE(empty.passed() == true);
+    REQUIRE(empty->empty());
+    REQUIRE(empty.remaining() == ";"sv);
+}
+
+TEST_CASE("separated_list trailing separator", "[separated_list]") {
+    auto res = list0("1,2,"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->size() == 2);
+    REQUIRE(res.remaining() == ","sv);
+}
+
+TEST_CASE("separated_list1", "[separated_list]") {
+    auto res = list1("4,5"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->size() == 2);
+
+    auto bad = list1(",5"sv);
+    REQUIRE(bad.passed() == false);
+    REQUIRE(bad.remaining() == ",5"sv);
+
+    STATIC_REQUIRE(decltype(list1)::first_set<char>()->contains('3'));
+    STATIC_REQUIRE(!decltype(list0)::first_set<char>().has_value());
+}
+
+TEST_CASE("separated_list reduce", "[separated_list]") {
+    static constexpr auto sum = separated_list1(
+        uint8,
+        byte,
+        [](unsigned total, uint8_t value) { return total + value; },
+        0u
+    );
+    static constexpr std::array<uint8_t, 6> data{1, 0, 2, 0, 3, 0};
+    auto res = sum(std::span{data});
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == 6);
+    REQUIRE(std::ranges::size(res.remaining()) == 1);
+}
+
+TEST_CASE("separated_list size hint", "[separated_list]") {
+    static constexpr auto hinted = separated_list0(
+        number,
+        verbatim<",">,
+        utils::default_reduce,
+        utils::default_reduce_init,
+        [](auto input) { return utils::count_of(',')(input) + 1; }
+    );
+    auto res = hinted("1,2,3,4,5,6,7,8,9,10,11"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->size() == 11);
+    REQUIRE(res->capacity() == 11);
+}
+
+TEST_CASE("separated_list streaming", "[separated_list]") {
+    static constexpr auto abs = separated_list0(verbatim<"ab">, verbatim<", ">);
+    auto res = abs(streaming_input("ab, a"sv));
+    REQUIRE(res.incomplete() == true);
+    REQUIRE(res.needed() == 1);
+
+    auto sep = abs(streaming_input("ab,"sv));
+    REQUIRE(sep.incomplete() == true);
+
+    auto done = abs(streaming_input("ab, ab;"sv));
+    REQUIRE(done.passed() == true);
+    REQUIRE(done->size() == 2);
+}
+
+TEST_CASE("separated_list constant evaluation", "[separated_list]") {
+    STATIC_REQUIRE(list0("1,2,3"sv)->size() == 3);
+    STATIC_REQUIRE(list0(""sv)->empty());
+}
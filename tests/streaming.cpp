@@ -0,0 +1,104 @@
+#include <ctpc/streaming.hpp>
+#include <ctpc/alt.hpp>
+#include <ctpc/integer.hpp>
+#include <ctpc/many0.hpp>
+#include <ctpc/seq.hpp>
+#include <ctpc/verbatim.hpp>
+#include "test_utils.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <span>
+#include <vector>
+
+using namespace ctpc;
+
+TEST_CASE("verbatim needs more input", "[streaming]") {
+    auto res = verbatim<"hello">(streaming_input("hel"sv));
+    REQUIRE(res.passed() == false);
+    REQUIRE(res.incomplete() == true);
+    REQUIRE(res.needed() == 2);
+
+    auto mismatch = verbatim<"hello">(streaming_input("hex"sv));
+    REQUIRE(mismatch.passed() == false);
+    REQUIRE(mismatch.incomplete() == false);
+
+    auto complete = verbatim<"hello">("hel"sv);
+    REQUIRE(complete.passed() == false);
+    REQUIRE(complete.incomplete() == false);
+}
+
+TEST_CASE("integer needs more input", "[streaming]") {
+    std::array<uint8_t, 2> bytes{0x01, 0x02};
+    auto res = uint32_be(streaming_input(std::span{bytes}));
+    REQUIRE(res.incomplete() == true);
+    REQUIRE(res.needed() == 2);
+
+    std::list<uint8_t> list{0x01, 0x02};
+    auto list_res = uint32_be(streaming_input(list));
+    REQUIRE(list_res.incomplete() == true);
+    REQUIRE(list_res.needed() >= 1);
+}
+
+TEST_CASE("combinators propagate incomplete results", "[streaming]") {
+    auto res = seq(verbatim<"ab">, verbatim<"cd">)(streaming_input("abc"sv));
+    REQUIRE(res.incomplete() == true);
+    REQUIRE(res.needed() == 1);
+
+    auto list = many0(verbatim<"ab">, [](size_t n, auto) { return n + 1; }, size_t{0});
+    auto partial = list(streaming_input("aba"sv));
+    REQUIRE(partial.incomplete() == true);
+    REQUIRE(partial.needed() == 1);
+    auto stopped = list("aba"sv);
+    REQUIRE(stopped.passed() == true);
+    REQUIRE(stopped.remaining() == "a"sv);
+
+    auto choice = alt(verbatim<"abc">, verbatim<"ab">);
+    REQUIRE(choice(streaming_input("ab"sv)).incomplete() == true);
+    REQUIRE(choice(streaming_input(""sv)).incomplete() == true);
+    REQUIRE(*choice(streaming_input("abd"sv)) == "ab"sv);
+}
+
+TEST_CASE("stream parser", "[streaming]") {
+    size_t calls = 0;
+    auto message = [&calls](Input auto input) {
+        ++calls;
+        return uint32_be(input);
+    };
+    auto stream = streaming<std::byte>(message);
+
+    std::vector<std::byte> data{};
+    for (uint32_t i = 0; i < 16; ++i) {
+        for (auto shift : {24, 16, 8, 0}) {
+            data.push_back(static_cast<std::byte>(i >> shift));
+        }
+    }
+
+    std::vector<uint32_t> values{};
+    for (auto b : data) {
+        stream.feed(std::span{&b, 1});
+        for (;;) {
+            auto res = stream.next();
+            if (!res) {
+                REQUIRE(res.incomplete() == true);
+                break;
+            }
+            values.push_back(*res);
+        }
+    }
+
+    REQUIRE(values.size() == 16);
+    for (uint32_t i = 0; i < 16; ++i) {
+        REQUIRE(values[i] == i);
+    }
+    REQUIRE(stream.buffered() == 0);
+    // Each message is parsed once when complete, and once more to find
+    // that the following message is missing, plus the very first attempt
+    REQUIRE(calls == 33);
+}
+
+TEST_CASE("constexpr", "[streaming]") {
+    STATIC_REQUIRE(verbatim<"abc">(streaming_input("ab"sv)).needed() == 1);
+}
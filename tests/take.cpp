@@ -0,0 +1,118 @@
+#include <ctpc/streaming.hpp>
+#include <ctpc/take.hpp>
+#include <array>
+#include <cstddef>
+#include <list>
+#include <string>
+#include <string_view>
+#include "test_utils.hpp"
+
+using namespace ctpc;
+
+static constexpr auto digits = take_while<[](char c) { return c >= '0' && c <= '9'; }>;
+static constexpr auto field = take_till<',', '\n'>;
+static constexpr auto header = take_until<"\r\n">;
+
+TEST_CASE("take_while", "[take]") {
+    auto res = digits("12345abc"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == "12345"sv);
+    REQUIRE(res.remaining() == "abc"sv);
+
+    auto none = digits("abc"sv);
+    REQUIRE(none.passed() == true);
+    REQUIRE(std::ranges::empty(*none));
+    REQUIRE(none.remaining() == "abc"sv);
+
+    auto all = digits("0123456789012345678901234567890123456789"sv);
+    REQUIRE(all.passed() == true);
+    REQUIRE(std::ranges::size(*all) == 40);
+    REQUIRE(std::ranges::empty(all.remaining()));
+
+    static constexpr auto high = take_while<[](char c) { return static_cast<unsigned char>(c) >= 0x80; }>;
+    auto utf8 = high("\xC3\xA9!"sv);
+    REQUIRE(std::ranges::size(*utf8) == 2);
+
+    STATIC_REQUIRE(*digits("42x"sv) == "42"sv);
+}
+
+TEST_CASE("take_while wide and non-contiguous inputs", "[take]") {
+    static constexpr auto letters = take_while<[](char32_t c) { return c != U' ' && c != U'.'; }>;
+    auto wide = letters(U"héllo\U0001F600 world"sv);
+    REQUIRE(wide.passed() == true);
+    REQUIRE(std::ranges::size(*wide) == 6);
+
+    std::list<char> chars{'7', '8', 'x'};
+    auto listed = digits(std::ranges::subrange(chars));
+    REQUIRE(listed.passed() == true);
+    REQUIRE(std::ranges::distance(*listed) == 2);
+}
+
+TEST_CASE("take_till", "[take]") {
+    auto res = field("alpha,beta"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == "alpha"sv);
+    REQUIRE(res.remaining() == ",beta"sv);
+
+    auto line = field("a long line of text without commas\nnext"sv);
+    REQUIRE(*line == "a long line of text without commas"sv);
+
+    auto rest = field("no delimiter"sv);
+    REQUIRE(rest.passed() == true);
+    REQUIRE(*rest == "no delimiter"sv);
+
+    static constexpr auto many = take_till<';', ',', ' ', '\t', '\n', '|'>;
+    auto wide_set = many("abcdefghijklmnopqrstuvwxyz|"sv);
+    REQUIRE(std::ranges::size(*wide_set) == 26);
+
+    static constexpr auto zero = take_till<std::byte{0}>;
+    static constexpr std::array<std::byte, 4> data{std::byte{1}, std::byte{2}, std::byte{0}, std::byte{3}};
+    auto bytes = zero(std::span{data});
+    REQUIRE(std::ranges::size(*bytes) == 2);
+
+    STATIC_REQUIRE(*field("x,y"sv) == "x"sv);
+}
+
+TEST_CASE("take_till matches every position", "[take]") {
+    std::string text(100, 'a');
+    for (size_t i = 0; i < text.size(); ++i) {
+        text[i] = '\n';
+        auto res = field(std::string_view{text});
+        REQUIRE(std::ranges::size(*res) == i);
+        text[i] = 'a';
+    }
+}
+
+TEST_CASE("take_until", "[take]") {
+    auto res = header("Host: example.com\r\nAccept: */*\r\n"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == "Host: example.com"sv);
+    REQUIRE(res.remaining() == "\r\nAccept: */*\r\n"sv);
+
+    auto partial = header("a\rb\r\r\n"sv);
+    REQUIRE(*partial == "a\rb\r"sv);
+
+    auto missing = header("no terminator\r"sv);
+    REQUIRE(missing.passed() == false);
+    REQUIRE(missing.remaining() == "no terminator\r"sv);
+
+    static constexpr auto end_comment = take_until<"*/">;
+    auto wide = end_comment(U"comment */ code"sv);
+    REQUIRE(std::ranges::size(*wide) == 8);
+
+    STATIC_REQUIRE(*header("k: v\r\n"sv) == "k: v"sv);
+    STATIC_REQUIRE(header("k: v"sv).passed() == false);
+}
+
+TEST_CASE("take streaming", "[take]") {
+    auto run = digits(streaming_input("123"sv));
+    REQUIRE(run.incomplete() == true);
+    REQUIRE(run.needed() == 1);
+    REQUIRE(digits(streaming_input("123;"sv)).passed() == true);
+
+    REQUIRE(field(streaming_input("abc"sv)).incomplete() == true);
+    REQUIRE(*field(streaming_input("abc,"sv)) == "abc"sv);
+
+    REQUIRE(header(streaming_input("abc\r"sv)).incomplete() == true);
+    REQUIRE(*header(streaming_input("abc\r\n"sv)) == "abc"sv);
+}
@@ -0,0 +1,115 @@
+#include <ctpc/alt.hpp>
+#include <ctpc/many0.hpp>
+#include <ctpc/map.hpp>
+#include <ctpc/seq.hpp>
+#include <ctpc/token.hpp>
+#include <string_view>
+#include <vector>
+#include "test_utils.hpp"
+
+using namespace ctpc;
+
+namespace {
+
+enum class Kind {
+    identifier,
+    number,
+    plus,
+    equals,
+    semicolon,
+};
+
+struct Tok {
+    Kind kind;
+    std::string_view text;
+};
+
+struct CallTok {
+    int id;
+
+    constexpr int kind() const {
+        return id / 10;
+    }
+};
+
+const std::vector<Tok> tokens{
+    {Kind::identifier, "x"},
+    {Kind::equals, "="},
+    {Kind::number, "1"},
+    {Kind::plus, "+"},
+    {Kind::identifier, "y"},
+    {Kind::semicolon, ";"},
+};
+
+}
+
+TEST_CASE("token kinds", "[token]") {
+    STATIC_REQUIRE(TokenElement<Tok>);
+    STATIC_REQUIRE(TokenElement<CallTok>);
+    STATIC_REQUIRE(TokenElement<Kind>);
+    STATIC_REQUIRE(!TokenElement<int>);
+    STATIC_REQUIRE(TokenInput<std::span<const Tok>>);
+    STATIC_REQUIRE(token_kind(CallTok{42}) == 4);
+    STATIC_REQUIRE(token_kind(Kind::plus) == Kind::plus);
+}
+
+TEST_CASE("token", "[token]") {
+    auto input = token_input(tokens);
+    auto res = token<Kind::identifier>(input);
+    REQUIRE(res.passed() == true);
+    REQUIRE(res->text == "x"sv);
+    REQUIRE(std::ranges::size(res.remaining()) == 5);
+
+    auto bad = token<Kind::number>(input);
+    REQUIRE(bad.passed() == false);
+    REQUIRE(std::ranges::size(bad.remaining()) == 6);
+
+    REQUIRE(token<Kind::number>(std::span<const Tok>{}).passed() == false);
+}
+
+TEST_CASE("token_if", "[token]") {
+    static constexpr auto operand = token_if([](const Tok& tok) {
+        return tok.kind == Kind::identifier || tok.kind == Kind::number;
+    });
+    auto input = token_input(tokens);
+    REQUIRE(operand(input).passed() == true);
+    REQUIRE(operand(input.subspan(1)).passed() == false);
+    REQUIRE(operand(input.subspan(2))->text == "1"sv);
+}
+
+TEST_CASE("token grammar", "[token]") {
+    static constexpr auto operand = alt(token<Kind::identifier>, token<Kind::number>);
+    static constexpr auto sum = seq(
+        operand,
+        many0(
+            seq(token<Kind::plus>, operand),
+            [](size_t count, auto, auto) { return count + 1; },
+            [] { return size_t{0}; }
+        )
+    );
+    static constexpr auto statement = seq(token<Kind::identifier>, token<Kind::equals>, sum, token<Kind::semicolon>);
+
+    auto res = statement(token_input(tokens));
+    REQUIRE(res.passed() == true);
+    REQUIRE(std::get<0>(*res).text == "x"sv);
+    REQUIRE(std::get<1>(std::get<2>(*res)) == 1);
+    REQUIRE(std::ranges::empty(res.remaining()));
+
+    STATIC_REQUIRE(decltype(operand)::first_set<Tok>().has_value());
+    STATIC_REQUIRE(decltype(operand)::first_set<Tok>()->contains(static_cast<uint32_t>(Kind::number)));
+    STATIC_REQUIRE(!decltype(operand)::first_set<Tok>()->contains(static_cast<uint32_t>(Kind::plus)));
+}
+
+TEST_CASE("enum tokens", "[token]") {
+    static constexpr std::array kinds{Kind::number, Kind::plus, Kind::number};
+    static constexpr auto expr = seq(token<Kind::number>, token<Kind::plus>, token<Kind::number>);
+    STATIC_REQUIRE(expr(token_input(kinds)).passed());
+    STATIC_REQUIRE(!expr(token_input(kinds).subspan(1)).passed());
+}
+
+TEST_CASE("streaming tokens", "[token]") {
+    auto input = streaming_input(token_input(tokens).first(1));
+    auto res = seq(token<Kind::identifier>, token<Kind::equals>)(input);
+    REQUIRE(res.incomplete() == true);
+    REQUIRE(res.needed() == 1);
+}
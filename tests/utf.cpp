@@ -20,3 +20,65 @@ UTF_CONVERT_FROM_TEST(char8_t, u8"abcd"sv)
 UTF_CONVERT_FROM_TEST(char16_t, u"abcd"sv)
 UTF_CONVERT_FROM_TEST(char32_t, U"abcd"sv)
 UTF_CONVERT_FROM_TEST(wchar_t, L"abcd"sv)
+
+TEST_CASE("utf_convert multibyte", "[utf_convert]") {
+    REQUIRE(ctpc::utils::utf_convert<char32_t>("\xc4\x80\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80"sv) == U"Āé€\U0001F600"sv);
+}
+
+TEST_CASE("utf_transcode", "[utf_transcode]") {
+    auto input = "ascii text that is longer than one block \xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80!"sv;
+    std::u16string out(ctpc::utils::utf_transcode_bound<char16_t, char>(input.size()), u'\0');
+    auto res = ctpc::utils::utf_transcode(input, out);
+    REQUIRE(res.status == ctpc::utils::UtfStatus::ok);
+    REQUIRE(res.read == input.size());
+    out.resize(res.written);
+    REQUIRE(out == u"ascii text that is longer than one block é€\U0001F600!"sv);
+
+    std::string back(ctpc::utils::utf_transcode_bound<char, char16_t>(out.size()), '\0');
+    auto back_res = ctpc::utils::utf_transcode(out, back);
+    REQUIRE(back_res.status == ctpc::utils::UtfStatus::ok);
+    back.resize(back_res.written);
+    REQUIRE(back == input);
+}
+
+TEST_CASE("utf_transcode invalid", "[utf_transcode]") {
+    std::u32string out(16, U'\0');
+    // Overlong encoding, surrogate, beyond U+10FFFF, and truncated sequence
+    for (auto input : {"ab\xc0\x80"sv, "ab\xed\xa0\x80"sv, "ab\xf4\x90\x80\x80"sv, "ab\xe2\x82"sv}) {
+        auto res = ctpc::utils::utf_transcode(input, out);
+        REQUIRE(res.status == ctpc::utils::UtfStatus::invalid);
+        REQUIRE(res.read == 2);
+        REQUIRE(res.written == 2);
+    }
+}
+
+TEST_CASE("utf_transcode output too small", "[utf_transcode]") {
+    std::string out(3, '\0');
+    auto res = ctpc::utils::utf_transcode(U"ab€"sv, out);
+    REQUIRE(res.status == ctpc::utils::UtfStatus::output_too_small);
+    REQUIRE(res.read == 2);
+    REQUIRE(res.written == 2);
+}
+
+TEST_CASE("utf_transcode constexpr", "[utf_transcode]") {
+    STATIC_REQUIRE([] {
+        std::array<char32_t, 4> out{};
+        auto res = ctpc::utils::utf_transcode("a\xc3\xa9"sv, out);
+        return res && res.written == 2 && out[1] == U'é';
+    }());
+}
+
+TEST_CASE("utf_is_ascii", "[utf_is_ascii]") {
+    auto text = "plain ascii text that spans several vector blocks of input"sv;
+    REQUIRE(ctpc::utils::utf_is_ascii(text) == true);
+    REQUIRE(ctpc::utils::utf_is_ascii(""sv) == true);
+    for (size_t i = 0; i < text.size(); ++i) {
+        std::string copy{text};
+        copy[i] = '\xc3';
+        REQUIRE(ctpc::utils::utf_is_ascii(copy) == false);
+    }
+    REQUIRE(ctpc::utils::utf_is_ascii(u"ascii in utf-16"sv) == true);
+    REQUIRE(ctpc::utils::utf_is_ascii(u"café"sv) == false);
+    REQUIRE(ctpc::utils::utf_is_ascii(U"\U0001F600"sv) == false);
+    STATIC_REQUIRE(ctpc::utils::utf_is_ascii("abc"sv));
+}
@@ -152,3 +152,38 @@ TEST_CASE("not multi character wchar_t", "[verbatim]") {
     REQUIRE(res.passed() == false);
     REQUIRE(res.remaining() == L"abcd"sv);
 }
+
+TEST_CASE("long literal char", "[verbatim]") {
+    const auto parser = verbatim<"abcdefghijklmnopqrstuvwxyz0123456789">;
+    auto res = parser("abcdefghijklmnopqrstuvwxyz0123456789!"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == "abcdefghijklmnopqrstuvwxyz0123456789"sv);
+    REQUIRE(res.remaining() == "!"sv);
+}
+
+TEST_CASE("long literal char16_t", "[verbatim]") {
+    const auto parser = verbatim<"abcdefghijklmnopqrstuvwxyz0123456789">;
+    auto res = parser(u"abcdefghijklmnopqrstuvwxyz0123456789!"sv);
+    REQUIRE(res.passed() == true);
+    REQUIRE(*res == u"abcdefghijklmnopqrstuvwxyz0123456789"sv);
+    REQUIRE(res.remaining() == u"!"sv);
+}
+
+TEST_CASE("not long literal char", "[verbatim]") {
+    const auto parser = verbatim<"abcdefghijklmnopqrstuvwxyz0123456789">;
+    auto res = parser("abcdefghijklmnopqrstuvwxyz012345678!"sv);
+    REQUIRE(res.passed() == false);
+    REQUIRE(res.remaining() == "abcdefghijklmnopqrstuvwxyz012345678!"sv);
+}
+
+TEST_CASE("short input char", "[verbatim]") {
+    const auto parser = verbatim<"abcd">;
+    auto res = parser("abc"sv);
+    REQUIRE(res.passed() == false);
+    REQUIRE(res.remaining() == "abc"sv);
+}
+
+TEST_CASE("constexpr char", "[verbatim]") {
+    STATIC_REQUIRE(verbatim<"ab">("abcd"sv).remaining() == "cd"sv);
+    STATIC_REQUIRE(verbatim<"ab">("acbd"sv).passed() == false);
+}